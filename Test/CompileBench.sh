@@ -0,0 +1,239 @@
+#!/bin/sh
+#
+#  CompileBench.sh
+#  Catch - Test
+#
+#  Created by the Catch contributors on 19/10/2026.
+#  Copyright 2026 the Catch contributors. All rights reserved.
+#
+#  Distributed under the Boost Software License, Version 1.0. (See accompanying
+#  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+#
+#  Generates test files that lean hard on the macros - thousands of CHECKs and
+#  REQUIREs over mixed types, hundreds of TEST_CASEs and SECTIONs, and many
+#  GENERATEs - and compiles each in a number of configurations, reporting the
+#  compile time, the compiler's peak memory and the object size. Run it (or
+#  "make compileBench") before and after a change to catch_capture.hpp and
+#  friends, so compile time regressions get caught like runtime ones.
+#
+#  Settings, from the environment:
+#    CXX              compiler (default g++)
+#    CONFIGS          ;-separated sets of flags (default "-O0;-O2")
+#    TEST_CASES       test cases per generated file (default 200)
+#    ASSERTIONS       assertions per test case in Assertions.cpp (default 20)
+#    SECTIONS         sections per test case in Sections.cpp (default 4)
+#    BENCH_DIR        where the sources, objects and results go
+#                     (default ../bin/compileBench)
+#    BASELINE         results file from an earlier run to compare against
+#                     (copied out of BENCH_DIR, as each run overwrites it)
+#    MAX_REGRESSION   percentage slower, or bigger, than the baseline that
+#                     counts as a regression (default 15)
+#
+#  The results are written to $BENCH_DIR/results.txt, tab separated, so they
+#  can be kept and passed back in as BASELINE. If any row regresses the exit
+#  code is 1
+#
+
+CXX=${CXX:-g++}
+CONFIGS=${CONFIGS:--O0;-O2}
+TEST_CASES=${TEST_CASES:-200}
+ASSERTIONS=${ASSERTIONS:-20}
+SECTIONS=${SECTIONS:-4}
+MAX_REGRESSION=${MAX_REGRESSION:-15}
+
+SCRIPT_DIR=$(cd "$(dirname "$0")" && pwd)
+ROOT_DIR=$(cd "$SCRIPT_DIR/.." && pwd)
+BENCH_DIR=${BENCH_DIR:-$ROOT_DIR/bin/compileBench}
+RESULTS=$BENCH_DIR/results.txt
+
+mkdir -p "$BENCH_DIR" || exit 1
+
+###############################################################################
+# Source generation
+
+header()
+{
+    printf '// Generated by CompileBench.sh - do not edit\n\n'
+    printf '#include "%s/catch.hpp"\n\n' "$ROOT_DIR"
+}
+
+# One assertion of each flavour, in turn, so every kind of operand and
+# comparison gets instantiated
+assertion()
+{
+    case $(( $2 % 12 )) in
+        0)  printf '    CHECK( i == %d );\n' "$1" ;;
+        1)  printf '    REQUIRE( u == %du );\n' "$1" ;;
+        2)  printf '    CHECK( l != -%dL );\n' "$2" ;;
+        3)  printf '    CHECK( d == Approx( %d.5 ) );\n' "$1" ;;
+        4)  printf '    CHECK( f > %d.0f );\n' "$1" ;;
+        5)  printf '    CHECK( c == '"'"'a'"'"' );\n' ;;
+        6)  printf '    CHECK_FALSE( !b );\n' ;;
+        7)  printf '    REQUIRE( s == "test%d" );\n' "$1" ;;
+        8)  printf '    CHECK( p[0] == '"'"'t'"'"' );\n' ;;
+        9)  printf '    CHECK( ptr == &i );\n' ;;
+        10) printf '    CHECK( s.size() >= %du );\n' "${#3}" ;;
+        11) printf '    REQUIRE_THROWS( throwIf( i == %d ) );\n' "$1" ;;
+    esac
+}
+
+generateAssertions()
+{
+    header
+    printf '#include <stdexcept>\n#include <string>\n\n'
+    printf 'namespace\n{\n    void throwIf( bool condition )\n    {\n'
+    printf '        if( condition )\n            throw std::domain_error( "thrown" );\n    }\n}\n\n'
+    t=0
+    while [ $t -lt "$TEST_CASES" ]; do
+        printf 'TEST_CASE( "./succeeding/compileBench/assertions/%d", "" )\n{\n' $t
+        printf '    int i = %d;\n    unsigned int u = %du;\n    long l = %dL;\n' $t $t $t
+        printf '    double d = %d.5;\n    float f = %d.5f;\n    char c = '"'"'a'"'"';\n' $t $t
+        printf '    bool b = true;\n    std::string s = "test%d";\n' $t
+        printf '    const char* p = "test%d";\n    int* ptr = &i;\n\n' $t
+        a=0
+        while [ $a -lt "$ASSERTIONS" ]; do
+            assertion $t $(( t + a )) "test$t"
+            a=$(( a + 1 ))
+        done
+        printf '}\n\n'
+        t=$(( t + 1 ))
+    done
+}
+
+generateSections()
+{
+    header
+    t=0
+    while [ $t -lt "$TEST_CASES" ]; do
+        printf 'TEST_CASE( "./succeeding/compileBench/sections/%d", "" )\n{\n' $t
+        printf '    int a = %d;\n    double b = %d.25;\n\n' $t $t
+        s=0
+        while [ $s -lt "$SECTIONS" ]; do
+            printf '    SECTION( "s%d", "" )\n    {\n' $s
+            printf '        CHECK( a + %d == %d );\n' $s $(( t + s ))
+            printf '        SECTION( "s%d/nested", "" )\n        {\n' $s
+            printf '            REQUIRE( b > %d );\n' $t
+            printf '            CHECK( b < %d );\n        }\n    }\n' $(( t + 1 ))
+            s=$(( s + 1 ))
+        done
+        printf '}\n\n'
+        t=$(( t + 1 ))
+    done
+}
+
+generateGenerators()
+{
+    header
+    t=0
+    while [ $t -lt "$TEST_CASES" ]; do
+        printf 'TEST_CASE( "./succeeding/compileBench/generators/%d", "" )\n{\n' $t
+        printf '    using namespace Catch::Generators;\n\n'
+        printf '    int i = GENERATE( between( %d, %d ) );\n' $t $(( t + 3 ))
+        printf '    int j = GENERATE( values( %d, %d, %d ) );\n\n' $t $(( t * 2 )) $(( t * 3 ))
+        printf '    CHECK( i >= %d );\n    CHECK( j >= i - 3 );\n}\n\n' $t
+        t=$(( t + 1 ))
+    done
+}
+
+generateMain()
+{
+    printf '// Generated by CompileBench.sh - do not edit\n\n'
+    printf '#include "%s/catch_with_main.hpp"\n' "$ROOT_DIR"
+}
+
+generateMain > "$BENCH_DIR/Main.cpp"
+generateAssertions > "$BENCH_DIR/Assertions.cpp"
+generateSections > "$BENCH_DIR/Sections.cpp"
+generateGenerators > "$BENCH_DIR/Generators.cpp"
+
+###############################################################################
+# Measurement
+
+# Runs a command, writing "<seconds> <peak kB>" to the file named first.
+# Uses GNU time where there is one, else Python, else just the time
+measure()
+{
+    out=$1
+    shift
+    if /usr/bin/time -f '%e %M' -o /dev/null true > /dev/null 2>&1; then
+        /usr/bin/time -f '%e %M' -o "$out" "$@"
+    elif command -v python3 > /dev/null 2>&1; then
+        python3 -c '
+import resource, subprocess, sys, time
+start = time.time()
+code = subprocess.call( sys.argv[2:] )
+peak = resource.getrusage( resource.RUSAGE_CHILDREN ).ru_maxrss
+open( sys.argv[1], "w" ).write( "%.2f %d\n" % ( time.time() - start, peak ) )
+sys.exit( code )' "$out" "$@"
+    else
+        start=$(date +%s)
+        "$@"
+        code=$?
+        echo "$(( $(date +%s) - start )) -" > "$out"
+        return $code
+    fi
+}
+
+objectBytes()
+{
+    # Code and data, without the (highly variable) debug info
+    size "$1" 2> /dev/null | awk 'NR == 2 { print $4 }'
+}
+
+printf 'config\tfile\tseconds\tpeak_kB\tobject_bytes\n' > "$RESULTS"
+printf '%-20s %-16s %8s %10s %12s\n' "config" "file" "seconds" "peak kB" "object bytes"
+
+failed=0
+IFS_SAVED=$IFS
+IFS=';'
+for config in $CONFIGS; do
+    IFS=$IFS_SAVED
+    tag=$(printf '%s' "$config" | tr -c 'A-Za-z0-9+=.\n-' '_')
+    for file in Main Assertions Sections Generators; do
+        obj=$BENCH_DIR/$file$tag.o
+        log=$BENCH_DIR/$file$tag.log
+        # $config is deliberately split into separate flags
+        if ! measure "$BENCH_DIR/measure.txt" $CXX -c $config "$BENCH_DIR/$file.cpp" -o "$obj" > "$log" 2>&1; then
+            echo "Failed to compile $file.cpp with $config:"
+            cat "$log"
+            failed=1
+            continue
+        fi
+        read seconds peak < "$BENCH_DIR/measure.txt"
+        bytes=$(objectBytes "$obj")
+        printf '%s\t%s\t%s\t%s\t%s\n' "$config" "$file" "$seconds" "$peak" "$bytes" >> "$RESULTS"
+        printf '%-20s %-16s %8s %10s %12s\n' "$config" "$file" "$seconds" "$peak" "$bytes"
+    done
+    IFS=';'
+done
+IFS=$IFS_SAVED
+
+[ $failed -eq 0 ] || exit 1
+
+###############################################################################
+# Comparison
+
+if [ -n "$BASELINE" ]; then
+    echo
+    echo "Compared with $BASELINE (regression threshold $MAX_REGRESSION%):"
+    awk -F '\t' -v limit="$MAX_REGRESSION" '
+        function change( now, was )
+        {
+            if( was == "" || was == "-" || now == "-" || was + 0 == 0 )
+                return 0
+            return ( now - was ) * 100 / was
+        }
+        NR == FNR { if( FNR > 1 ) { s[$1 FS $2] = $3; m[$1 FS $2] = $4; o[$1 FS $2] = $5 } next }
+        FNR == 1 { next }
+        {
+            key = $1 FS $2
+            if( !( key in s ) )
+                next
+            ds = change( $3, s[key] ); dm = change( $4, m[key] ); do_ = change( $5, o[key] )
+            flag = ( ds > limit || dm > limit || do_ > limit ) ? "  <-- REGRESSION" : ""
+            if( flag != "" )
+                regressed = 1
+            printf "%-20s %-16s time %+6.1f%%  memory %+6.1f%%  size %+6.1f%%%s\n", $1, $2, ds, dm, do_, flag
+        }
+        END { exit regressed }' "$BASELINE" "$RESULTS" || exit 1
+fi
@@ -13,6 +13,7 @@
 #include "../catch.hpp"
 
 #include <string>
+#include <vector>
 
 struct TestData
 {
@@ -96,6 +97,40 @@ TEST_CASE( "./failing/conditions/inequality", "Inequality checks that should fai
     CHECK( data.str_hello.size() != 5 );
 }
 
+// Approx tolerances
+TEST_CASE( "./succeeding/conditions/approx", "Approx comparisons with explicit tolerances" )
+{
+    TestData data;
+
+    REQUIRE( data.double_pi == Approx( 3.14 ).epsilon( 0.001 ) );
+    REQUIRE( data.double_pi == Approx( 3.1 ).margin( 0.05 ) );
+    REQUIRE( 1.0 + 1e-15 == Approx( 1.0 ).epsilon( 0 ).margin( 0 ).ulps( 8 ) );
+    REQUIRE( data.float_nine_point_one == Approx( 9.100001f ).epsilon( 0 ).ulps( 2 ) );
+
+    std::vector<double> values( 100, 0.1 );
+    for( std::size_t i = 0; i < values.size(); ++i )
+        values[i] *= static_cast<double>( i ) * 3;
+    std::vector<double> expected( values.size() );
+    for( std::size_t i = 0; i < expected.size(); ++i )
+        expected[i] = static_cast<double>( i ) * 0.3;
+    REQUIRE( values == Approx( expected ) );
+    REQUIRE( std::vector<float>( 10, 0.5f ) == Approx( 0.5 ) );
+    REQUIRE( std::vector<double>() == Approx( std::vector<double>() ) );
+    REQUIRE( std::vector<float>() == Approx( 0.5 ) );
+}
+
+TEST_CASE( "./failing/conditions/approx", "Approx comparisons that should fail" )
+{
+    TestData data;
+
+    CHECK( data.double_pi == Approx( 3.14 ).epsilon( 0.0001 ) );
+    CHECK( 1.0 + 1e-14 == Approx( 1.0 ).epsilon( 0 ).margin( 0 ).ulps( 8 ) );
+
+    std::vector<double> values( 3, 1.0 );
+    CHECK( values == Approx( std::vector<double>( 3, 1.01 ) ) );
+    CHECK( values == Approx( std::vector<double>( 2, 1.0 ) ) );
+}
+
 // Ordering comparison tests
 TEST_CASE( "./succeeding/conditions/ordered", "Ordering comparison checks that should succeed" )
 {
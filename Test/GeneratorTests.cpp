@@ -11,6 +11,12 @@
  */
 
 #include "../catch.hpp"
+#include "../internal/catch_pairwise.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <limits>
+#include <numeric>
 
 size_t multiply( int a, int b )
 {
@@ -27,3 +33,170 @@ TEST_CASE( "./succeeding/generators/1", "Generators over two ranges" )
     REQUIRE( multiply( i, 2 ) == i*2 );
     REQUIRE( multiply( j, 2 ) == j*2 );
 }
+
+namespace
+{
+    int square( int i )
+    {
+        return i*i;
+    }
+
+    bool isEven( int i )
+    {
+        return i % 2 == 0;
+    }
+
+    bool isPositive( int i )
+    {
+        return i > 0;
+    }
+}
+
+TEST_CASE( "./succeeding/generators/lazy", "Random values, limited with take" )
+{
+    using namespace Catch::Generators;
+    
+    int r = GENERATE( take( 10, random( -5, 5 ) ) );
+    CHECK( r >= -5 );
+    CHECK( r <= 5 );
+}
+
+TEST_CASE( "./failing/generators/infinite", "An infinite generator can't be run to the end" )
+{
+    using namespace Catch::Generators;
+    
+    int r = GENERATE( random( -5, 5 ) );
+    CHECK( r >= -5 );
+}
+
+TEST_CASE( "./succeeding/generators/filter", "Only the values that match are generated" )
+{
+    using namespace Catch::Generators;
+    
+    int i = GENERATE( take( 5, filter( isEven, map( square, between( 1, 100 ) ) ) ) );
+    CHECK( i % 2 == 0 );
+}
+
+TEST_CASE( "./failing/generators/filter/nomatch", "Filtering an infinite generator that stops matching gives up" )
+{
+    using namespace Catch::Generators;
+    
+    int i = GENERATE( take( 3, filter( isPositive, random( -5, -1 ) ) ) );
+    CHECK( i > 0 );
+}
+
+TEST_CASE( "./succeeding/generators/chunk", "Values can be generated in groups" )
+{
+    using namespace Catch::Generators;
+    
+    std::vector<int> c = GENERATE( chunk( 3, between( 1, 9 ) ) );
+    REQUIRE( c.size() == 3u );
+    CHECK( c[1] - c[0] == 1 );
+}
+
+TEST_CASE( "./succeeding/generators/conditional", "A GENERATE that the first run doesn't reach" )
+{
+    using namespace Catch::Generators;
+    
+    int i = GENERATE( between( 1, 4 ) );
+    if( i > 1 )
+    {
+        int j = GENERATE( between( 1, 2 ) );
+        CHECK( j <= i );
+    }
+    CHECK( i >= 1 );
+}
+
+TEST_CASE( "./succeeding/generators/conditionalSections", "Sections that the first run doesn't reach" )
+{
+    using namespace Catch::Generators;
+    
+    int i = GENERATE( between( 1, 4 ) );
+    if( i > 1 )
+    {
+        SECTION( "more than one", "" )
+        {
+            CHECK( i > 1 );
+        }
+        SECTION( "at least two", "" )
+        {
+            CHECK( i >= 2 );
+        }
+    }
+    CHECK( i >= 1 );
+}
+
+TEST_CASE( "./succeeding/generators/pairwise", "Every pair of values is covered by far fewer rows than every combination" )
+{
+    std::vector<std::size_t> sizes;
+    sizes.push_back( 10 );
+    sizes.push_back( 3 );
+    sizes.push_back( 10 );
+    sizes.push_back( 5 );
+    sizes.push_back( 10 );
+    std::vector<std::vector<std::size_t> > rows = Catch::makePairwiseCoveringArray( sizes );
+    
+    std::size_t pairsSeen = 0;
+    std::size_t pairsExpected = 0;
+    for( std::size_t a = 0; a < sizes.size(); ++a )
+    {
+        for( std::size_t b = a+1; b < sizes.size(); ++b )
+        {
+            pairsExpected += sizes[a] * sizes[b];
+            std::vector<bool> seen( sizes[a] * sizes[b], false );
+            for( std::size_t r = 0; r < rows.size(); ++r )
+                seen[rows[r][a] * sizes[b] + rows[r][b]] = true;
+            pairsSeen += static_cast<std::size_t>( std::count( seen.begin(), seen.end(), true ) );
+        }
+    }
+    
+    CHECK( pairsSeen == pairsExpected );
+    CHECK( rows.size() < 150u );
+    CHECK( std::count( rows[0].begin(), rows[0].end(), 0u ) == 5 );
+}
+
+PROPERTY( "./succeeding/property/abs", "A property that holds for every value tried", int, i, random( -1000, 1000 ) )
+{
+    CHECK( std::abs( i ) >= 0 );
+    REQUIRE( std::abs( i ) <= 1000 );
+}
+
+PROPERTY( "./failing/property/shrink", "A failing value is shrunk to the smallest one that still fails", int, i, random( 0, 10000 ) )
+{
+    CHECK( i < 500 );
+}
+
+PROPERTY( "./failing/property/vector", "Failing vectors are shrunk too", std::vector<int>, v, chunk( 4, random( -10, 10 ) ) )
+{
+    CHECK( std::accumulate( v.begin(), v.end(), 0 ) < 20 );
+}
+
+PROPERTY( "./failing/property/empty", "A property needs values to be tried with", int, i, take( 0, between( 1, 3 ) ) )
+{
+    CHECK( i > 0 );
+}
+
+namespace
+{
+    int flakyCalls = 0;
+
+    void failsOnlyOnce( int )
+    {
+        if( ++flakyCalls == 1 )
+            FAIL( "Only the first call fails" );
+    }
+}
+
+TEST_CASE( "./failing/property/flaky", "A property that passes when run again is still falsified" )
+{
+    flakyCalls = 0;
+    Catch::checkProperty<int>( Catch::Generators::between( 1, 3 ), &failsOnlyOnce, "i", __FILE__, __LINE__ );
+}
+
+TEST_CASE( "./succeeding/property/shrink/limits", "The most negative value is shrunk without overflowing" )
+{
+    std::vector<int> candidates = Catch::Shrinker<int>::shrink( std::numeric_limits<int>::min() );
+    REQUIRE( !candidates.empty() );
+    CHECK( candidates[0] == 0 );
+    CHECK( std::count_if( candidates.begin(), candidates.end(), isPositive ) == 0 );
+}
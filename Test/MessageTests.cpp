@@ -48,4 +48,17 @@ TEST_CASE( "./mixed/message/info/2", "INFO gets logged on failure" )
 TEST_CASE( "./failing/message/fail", "FAIL aborts the test" )
 {
     FAIL( "This is a " << "failure" );    // This should output the message and abort
-}
\ No newline at end of file
+}
+
+TEST_CASE( "./failing/message/scoped", "SCOPED_INFO gets logged when something fails within its scope" )
+{
+    {
+        SCOPED_INFO( "this message should not be logged, as it's out of scope" );
+    }
+    std::string name = "value";
+    int value = 2;
+    SCOPED_INFO( "this message should be logged" );
+    SCOPED_INFO( "the " << name << " is " << value << ", a " << 'c' << " and " << 1.5 );
+    SCOPED_INFO( "and this, from a temporary: " << std::string( "temporary" ).c_str() );
+    REQUIRE( value == 1 );
+}
@@ -11,7 +11,9 @@
  */
 
 #include "../catch.hpp"
+#include "../internal/catch_thread.hpp"
 #include <iostream>
+#include <memory>
 
 TEST_CASE( "./succeeding/Misc/Sections", "random SECTION tests" )
 {
@@ -79,3 +81,94 @@ TEST_CASE( "./succeeding/Misc/stdout,stderr", "Sends stuff to stdout and stderr"
     
     std::cerr << "An error";
 }
+
+namespace
+{
+    struct Checker : Catch::IRunnable
+    {
+        virtual void run()
+        {
+            for( int i=0; i < 25; ++i )
+                CHECK( i < 25 );
+        }
+    };
+}
+
+TEST_CASE( "./succeeding/Misc/threads", "Makes assertions from several threads at once" )
+{
+    Checker checker;
+    Catch::Thread t1( checker ), t2( checker ), t3( checker ), t4( checker );
+}
+
+namespace
+{
+    int liveCounters = 0;
+
+    struct Counter
+    {
+        Counter(){ ++liveCounters; }
+        ~Counter(){ --liveCounters; }
+    };
+
+    // Takes its own Counter, then holds on to it until told to finish
+    struct CounterUser : Catch::IRunnable
+    {
+        CounterUser( Catch::ThreadLocal<Counter>& counters ) : m_counters( counters ), m_ready( false ), m_finished( false ){}
+
+        virtual void run()
+        {
+            m_counters.get();
+            Catch::ScopedLock lock( m_mutex );
+            m_ready = true;
+            m_condition.broadcast();
+            while( !m_finished )
+                m_condition.wait( m_mutex );
+        }
+
+        Catch::ThreadLocal<Counter>& m_counters;
+        Catch::Mutex m_mutex;
+        Catch::Condition m_condition;
+        bool m_ready;
+        bool m_finished;
+    };
+}
+
+TEST_CASE( "./succeeding/Misc/threadLocal", "A ThreadLocal deletes every thread's value, including those of threads still running" )
+{
+    std::auto_ptr<Catch::ThreadLocal<Counter> > counters( new Catch::ThreadLocal<Counter>() );
+    CounterUser user( *counters );
+    Catch::Thread thread( user );
+    {
+        Catch::ScopedLock lock( user.m_mutex );
+        while( !user.m_ready )
+            user.m_condition.wait( user.m_mutex );
+    }
+    counters->get();
+    CHECK( liveCounters == 2 );
+
+    counters.reset();
+    CHECK( liveCounters == 0 );
+
+    Catch::ScopedLock lock( user.m_mutex );
+    user.m_finished = true;
+    user.m_condition.broadcast();
+}
+
+TEST_CASE( "./succeeding/Misc/toString", "Builtins, pointers and containers are stringified without a stream" )
+{
+    using Catch::toString;
+
+    CHECK( toString( -2147483647 - 1 ) == "-2147483648" );
+    CHECK( toString( 18446744073709551615ULL ) == "18446744073709551615" );
+    CHECK( toString( true ) == "true" );
+    CHECK( toString( 0.1 ) == "0.1" );
+    CHECK( toString( 0.1 + 0.2 ) == "0.30000000000000004" );
+    CHECK( toString( 0.1f ) == "0.1" );
+    CHECK( toString( static_cast<int*>( NULL ) ) == "NULL" );
+
+    std::vector<int> v( 1000, 7 );
+    std::string str = toString( v );
+    CHECK( str.size() < 200 );
+    CHECK( str.substr( str.size() - 19 ) == " ... and 968 more }" );
+    CHECK( toString( std::make_pair( 1.5, std::string( "x" ) ) ) == "{ 1.5, x }" );
+}
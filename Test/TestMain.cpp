@@ -14,6 +14,188 @@
 
 #include "../internal/catch_self_test.hpp"
 
+namespace
+{
+    // Runs the tests matching the spec as a group, with the config's
+    // reporter(s)
+    void runGroup
+    (
+        Catch::Config& config,
+        const std::string& rawTestSpec
+    )
+    {
+        Catch::Runner runner( config );
+        runner.startGroup( rawTestSpec );
+        runner.runMatching( rawTestSpec );
+        runner.endGroup();
+    }
+
+    // Runs the tests matching the spec through the named reporter, returning
+    // everything it wrote
+    std::string reportOf
+    (
+        const std::string& reporterName,
+        const std::string& rawTestSpec
+    )
+    {
+        std::ostringstream oss;
+        Catch::Config config;
+        config.setStreamBuf( oss.rdbuf() );
+        config.setIncludeWhat( Catch::Config::Include::SuccessfulResults );
+        config.setRngSeed( 1234 );
+        config.setReporter( reporterName );
+        runGroup( config, rawTestSpec );
+        config.setStreamBuf( NULL );
+        return oss.str();
+    }
+
+    // Runs the tests matching the spec through the basic reporter, with a
+    // seed picked for the run as Main would
+    std::string seededReportOf
+    (
+        const std::string& rawTestSpec,
+        Catch::Config::Order::What order
+    )
+    {
+        std::ostringstream oss;
+        Catch::Config config;
+        config.setStreamBuf( oss.rdbuf() );
+        config.setOrder( order );
+        config.chooseRngSeed( 12345 );
+        config.setReporter( "basic" );
+        runGroup( config, rawTestSpec );
+        config.setStreamBuf( NULL );
+        return oss.str();
+    }
+
+    // The whole contents of a file
+    std::string readFile
+    (
+        const std::string& filename
+    )
+    {
+        std::ifstream ifs( filename.c_str(), std::ios_base::in | std::ios_base::binary );
+        std::ostringstream oss;
+        oss << ifs.rdbuf();
+        return oss.str();
+    }
+
+    // The names of the test cases matching the spec, in the order they are
+    // run with the given seed
+    std::string randomOrderOf
+    (
+        const std::string& rawTestSpec,
+        unsigned int seed
+    )
+    {
+        std::ostringstream oss;
+        Catch::Config config;
+        config.setStreamBuf( oss.rdbuf() );
+        config.setOrder( Catch::Config::Order::Random );
+        config.setRngSeed( seed );
+        config.setReporter( "xml" );
+        runGroup( config, rawTestSpec );
+        config.setStreamBuf( NULL );
+
+        std::string xml = oss.str();
+        std::string names;
+        const std::string tag = "<TestCase name=\"";
+        for( std::size_t pos = xml.find( tag ); pos != std::string::npos; pos = xml.find( tag, pos ) )
+        {
+            pos += tag.size();
+            names += xml.substr( pos, xml.find( '"', pos ) - pos ) + "\n";
+        }
+        return names;
+    }
+
+    // Runs the tests matching the spec with results cached in "selfTestCache",
+    // returning what the xml reporter wrote
+    std::string cachedReportOf
+    (
+        const std::string& rawTestSpec,
+        std::size_t repeatCount = 0,
+        const std::string& stateFilename = ""
+    )
+    {
+        std::ostringstream oss;
+        Catch::Config config;
+        config.setStreamBuf( oss.rdbuf() );
+        config.setIncludeWhat( Catch::Config::Include::SuccessfulResults );
+        config.chooseRngSeed( 12345 );
+        config.setCacheDir( "selfTestCache" );
+        config.setRepeatCount( repeatCount );
+        config.setStateFilename( stateFilename );
+        config.setReporter( "xml" );
+        runGroup( config, rawTestSpec );
+        config.setStreamBuf( NULL );
+        return oss.str();
+    }
+
+    // Two runs going at once, each on a thread of its own. Each is started
+    // only once the other has begun, so neither was simply the last to start
+    struct ConcurrentRuns
+    {
+        ConcurrentRuns() : m_stage( 0 ){}
+
+        // Waits for the other run to reach the stage, then moves on to the next
+        void waitFor( int stage )
+        {
+            Catch::ScopedLock lock( m_mutex );
+            while( m_stage < stage )
+                m_condition.wait( m_mutex );
+            m_stage = stage+1;
+            m_condition.broadcast();
+        }
+
+        Catch::Mutex m_mutex;
+        Catch::Condition m_condition;
+        int m_stage;
+    };
+
+    struct ConcurrentRun : Catch::IRunnable
+    {
+        ConcurrentRun( ConcurrentRuns& runs, int firstStage ) : m_runs( runs ), m_firstStage( firstStage ), m_succeeded( 0 ){}
+
+        virtual void run()
+        {
+            Catch::SelfTestReporter* reporter = new Catch::SelfTestReporter();
+            Catch::Config config;
+            config.setReporter( reporter );
+            {
+                Catch::Runner runner( config );
+                m_runs.waitFor( m_firstStage );
+                m_runs.waitFor( m_firstStage+2 );
+                runner.runMatching( "./succeeding/Misc/threads" );
+                m_runs.waitFor( m_firstStage+4 );
+            }
+            m_succeeded = reporter->getSucceeded();
+        }
+
+        ConcurrentRuns& m_runs;
+        int m_firstStage;
+        std::size_t m_succeeded;
+    };
+
+    // Replays a binary log through the named reporter, returning everything
+    // it wrote
+    std::string convert
+    (
+        const std::string& binaryLog,
+        const std::string& reporterName
+    )
+    {
+        std::ostringstream oss;
+        Catch::Config config;
+        config.setStreamBuf( oss.rdbuf() );
+        config.setIncludeWhat( Catch::Config::Include::SuccessfulResults );
+        config.setReporter( reporterName );
+        std::istringstream iss( binaryLog );
+        std::string error = Catch::BinaryLogReader( iss ).replay( config );
+        config.setStreamBuf( NULL );
+        return error.empty() ? oss.str() : error;
+    }
+}
+
 TEST_CASE( "selftest/main", "Runs all Catch self tests and checks their results" )
 {
     using namespace Catch;
@@ -21,10 +203,385 @@ TEST_CASE( "selftest/main", "Runs all Catch self tests and checks their results"
     EmbeddedRunner runner;
 
     runner.runMatching( "./succeeding/*" );
-    CHECK( runner.getReporter().getSucceeded() == 196 );
+    CHECK( runner.getReporter().getSucceeded() == 376 );
     CHECK( runner.getReporter().getFailed() == 0 );
 
     runner.runMatching( "./failing/*" );        
     CHECK( runner.getReporter().getSucceeded() == 0 );
-    CHECK( runner.getReporter().getFailed() == 53 );
+    CHECK( runner.getReporter().getFailed() == 68 );
+}
+
+TEST_CASE( "selftest/commandline/counts", "Counts given on the command line must be plain positive numbers" )
+{
+    using namespace Catch;
+
+    const char* valid[] = { "catchTest", "--abort-after", "3" };
+    Config validConfig;
+    ArgParser( 3, const_cast<char* const*>( valid ), validConfig );
+    CHECK( validConfig.getMessage().empty() );
+    CHECK( validConfig.getAbortAfter() == 3 );
+
+    const char* counts[] = { "-1", "+1", " 1", "1x", "0", "" };
+    for( std::size_t i = 0; i < sizeof( counts ) / sizeof( counts[0] ); ++i )
+    {
+        const char* argv[] = { "catchTest", "--abort-after", counts[i] };
+        Config config;
+        ArgParser( 3, const_cast<char* const*>( argv ), config );
+        INFO( counts[i] );
+        CHECK( !config.getMessage().empty() );
+    }
+}
+
+TEST_CASE( "selftest/commandline/rngSeed", "Any seed can be given, zero included, to reproduce a run" )
+{
+    using namespace Catch;
+
+    Config defaultConfig;
+    CHECK( !defaultConfig.isRngSeedGiven() );
+
+    const char* zero[] = { "catchTest", "--rng-seed", "0" };
+    Config zeroConfig;
+    ArgParser( 3, const_cast<char* const*>( zero ), zeroConfig );
+    CHECK( zeroConfig.getMessage().empty() );
+    CHECK( zeroConfig.isRngSeedGiven() );
+    CHECK( zeroConfig.getOutcomeOptions().find( "rng-seed=0" ) != std::string::npos );
+
+    const char* tooBig[] = { "catchTest", "--rng-seed", "4294967296" };
+    Config tooBigConfig;
+    ArgParser( 3, const_cast<char* const*>( tooBig ), tooBigConfig );
+    CHECK( !tooBigConfig.getMessage().empty() );
+}
+
+TEST_CASE( "selftest/rngSeed/reported", "A picked seed is shown for a random order, or with a failure that used it" )
+{
+    using namespace Catch;
+
+    const std::string header = "[Randomness seeded to: 12345]";
+    const std::string rerun = "rerun with --rng-seed 12345";
+
+    std::string passing = seededReportOf( "./succeeding/generators/lazy", Config::Order::Declared );
+    CHECK( passing.find( header ) == std::string::npos );
+    CHECK( passing.find( rerun ) == std::string::npos );
+
+    std::string unseeded = seededReportOf( "./failing/conditions/equality", Config::Order::Declared );
+    CHECK( unseeded.find( rerun ) == std::string::npos );
+
+    std::string failing = seededReportOf( "./failing/generators/filter/nomatch", Config::Order::Declared );
+    CHECK( failing.find( header ) == std::string::npos );
+    CHECK( failing.find( rerun ) != std::string::npos );
+
+    std::string shuffled = seededReportOf( "./failing/generators/filter/nomatch", Config::Order::Random );
+    CHECK( shuffled.find( header ) != std::string::npos );
+    CHECK( shuffled.find( rerun ) == std::string::npos );
+}
+
+TEST_CASE( "selftest/commandline/reporters", "An unknown reporter is an error, whether it is given first or later" )
+{
+    using namespace Catch;
+
+    const char* known[] = { "catchTest", "-r", "xml" };
+    Config knownConfig;
+    ArgParser( 3, const_cast<char* const*>( known ), knownConfig );
+    CHECK( knownConfig.getMessage().empty() );
+
+    const char* first[] = { "catchTest", "-r", "bogus" };
+    Config firstConfig;
+    ArgParser( 3, const_cast<char* const*>( first ), firstConfig );
+    CHECK( firstConfig.getMessage().find( "Unknown reporter: bogus" ) != std::string::npos );
+
+    const char* later[] = { "catchTest", "-r", "xml", "-r", "bogus" };
+    Config laterConfig;
+    ArgParser( 5, const_cast<char* const*>( later ), laterConfig );
+    CHECK( laterConfig.getMessage().find( "Unknown reporter: bogus" ) != std::string::npos );
+}
+
+TEST_CASE( "selftest/cache", "Cached results are reused only for the same build and options" )
+{
+    using namespace Catch;
+
+    Config config;
+    config.setTimeout( 10 );
+    config.chooseRngSeed( 12345 );
+    std::string key = "build-1\n" + config.getOutcomeOptions();
+    {
+        ResultCache cache( "selfTestCache", key );
+        std::size_t successes = 0;
+        CHECK( !cache.lookup( "a test", successes ) );
+
+        cache.store( "a test", 7 );
+        REQUIRE( cache.lookup( "a test", successes ) );
+        CHECK( successes == 7 );
+        CHECK( !cache.lookup( "another test", successes ) );
+
+        // Another build, or other options, don't see the result
+        CHECK( !ResultCache( "selfTestCache", "build-2\n" + config.getOutcomeOptions() ).lookup( "a test", successes ) );
+        config.setTimeout( 20 );
+        CHECK( !ResultCache( "selfTestCache", "build-1\n" + config.getOutcomeOptions() ).lookup( "a test", successes ) );
+        config.setTimeout( 10 );
+
+        // A seed picked for the run doesn't change the key, one given does
+        config.chooseRngSeed( 54321 );
+        CHECK( ResultCache( "selfTestCache", "build-1\n" + config.getOutcomeOptions() ).lookup( "a test", successes ) );
+        config.setRngSeed( 54321 );
+        CHECK( !ResultCache( "selfTestCache", "build-1\n" + config.getOutcomeOptions() ).lookup( "a test", successes ) );
+
+        // A failure invalidates the result
+        cache.remove( "a test" );
+        CHECK( !cache.lookup( "a test", successes ) );
+    }
+    std::remove( "selfTestCache" );
+}
+
+TEST_CASE( "selftest/cache/runner", "Passes are only reused when a run could reproduce them" )
+{
+    using namespace Catch;
+
+    const std::string notRun = "Not run - passed last time";
+    cachedReportOf( "./succeeding/Misc/Sections" );
+    CHECK( cachedReportOf( "./succeeding/Misc/Sections" ).find( notRun ) != std::string::npos );
+
+    // A stress run runs the test however it did last time
+    CHECK( cachedReportOf( "./succeeding/Misc/Sections", 5 ).find( notRun ) == std::string::npos );
+
+    // A cached pass is still recorded as a pass
+    cachedReportOf( "./succeeding/Misc/Sections", 0, "selfTestState" );
+    RunState state;
+    REQUIRE( state.load( "selfTestState" ) );
+    std::remove( "selfTestState" );
+    unsigned long long durationMs = 0;
+    CHECK( state.getDuration( "./succeeding/Misc/Sections", durationMs ) );
+    CHECK( state.getFailedTestNames().empty() );
+
+    // Random values from a seed picked for this run might fail next time
+    cachedReportOf( "./succeeding/generators/lazy" );
+    CHECK( cachedReportOf( "./succeeding/generators/lazy" ).find( notRun ) == std::string::npos );
+
+    Config config;
+    config.chooseRngSeed( 12345 );
+    ResultCache cache( "selfTestCache", "\n" + config.getOutcomeOptions() );
+    cache.remove( "./succeeding/Misc/Sections" );
+    cache.remove( "./succeeding/generators/lazy" );
+    std::remove( "selfTestCache" );
+}
+
+TEST_CASE( "selftest/state", "Failed test cases are saved, loaded and rerun by their exact names" )
+{
+    using namespace Catch;
+
+    {
+        RunState state;
+        state.record( "./succeeding/Misc/Sections", true, 5 );
+        state.record( "./failing/message/fail", false, 7 );
+        state.record( "./failing/*", false, 3 );
+        REQUIRE( state.save( "selfTestState" ) );
+    }
+    RunState state;
+    REQUIRE( state.load( "selfTestState" ) );
+    std::remove( "selfTestState" );
+
+    unsigned long long durationMs = 0;
+    CHECK( state.getDuration( "./failing/message/fail", durationMs ) );
+    CHECK( durationMs == 7 );
+
+    std::vector<std::string> failedTests = state.getFailedTestNames();
+    REQUIRE( failedTests.size() == 2 );
+    CHECK( failedTests[0] == "./failing/*" );
+    CHECK( failedTests[1] == "./failing/message/fail" );
+
+    // A name ending in '*' is not a wildcard
+    EmbeddedRunner runner;
+    CHECK( runner.runNamed( failedTests[0] ) == 0 );
+    CHECK( runner.runNamed( failedTests[1] ) == 1 );
+    CHECK( runner.getReporter().getFailed() == 1 );
+}
+
+TEST_CASE( "selftest/async", "Every event reaches the reporter through the async queue, even when it is full" )
+{
+    using namespace Catch;
+
+    SelfTestReporter* reporter = new SelfTestReporter();
+    Config config;
+    // A small queue, so the test threads keep having to wait for it to drain
+    config.setReporter( new AsyncReporter( reporter, 4 ) );
+    {
+        Runner runner( config );
+        runner.runMatching( "./succeeding/Misc/threads" );
+        runner.runMatching( "./failing/message/*" );
+    }
+    CHECK( reporter->getSucceeded() == 100 );
+    CHECK( reporter->getFailed() == 3 );
+}
+
+TEST_CASE( "selftest/binary", "A binary log converts to the same output as the reporter writes directly" )
+{
+    std::string binaryLog = reportOf( "binary", "./mixed/*" );
+    REQUIRE( binaryLog.substr( 0, 8 ) == "CATCHBIN" );
+
+    std::string xml = reportOf( "xml", "./mixed/*" );
+    CHECK( xml.find( "<Expression" ) != std::string::npos );
+    CHECK( xml.find( "rng-seed=\"1234\"" ) != std::string::npos );
+    CHECK( convert( binaryLog, "xml" ) == xml );
+    CHECK( convert( binaryLog, "junit" ) == reportOf( "junit", "./mixed/*" ) );
+
+    // A corrupt record length is caught before anything is allocated for it
+    std::string corruptLog = binaryLog;
+    corruptLog.replace( 10, 4, "\xff\xff\xff\x7f" );
+    CHECK( convert( corruptLog, "xml" ) == "Corrupt Catch binary log" );
+
+    // Converting gives the same result as the logged run
+    {
+        std::ofstream ofs( "selfTestBinary.log", std::ios::out | std::ios::binary );
+        ofs << binaryLog;
+    }
+    std::ostringstream oss;
+    Catch::Config config;
+    config.setStreamBuf( oss.rdbuf() );
+    config.setReporter( "xml" );
+    config.setConvertFilename( "selfTestBinary.log" );
+    int failures = Catch::Convert( config );
+    config.setStreamBuf( NULL );
+    std::remove( "selfTestBinary.log" );
+
+    Catch::EmbeddedRunner runner;
+    runner.runMatching( "./mixed/*" );
+    CHECK( runner.getReporter().getFailed() > 0 );
+    CHECK( failures == static_cast<int>( runner.getReporter().getFailed() ) );
+}
+
+TEST_CASE( "selftest/generators/threads", "A GENERATE that only later runs reach fails loudly when values are shared between threads" )
+{
+    using namespace Catch;
+
+    SelfTestReporter* reporter = new SelfTestReporter();
+    Config config;
+    config.setReporter( reporter );
+    config.setGeneratorThreads( 2 );
+    {
+        Runner runner( config );
+        runner.runMatching( "./succeeding/generators/conditional" );
+    }
+    CHECK( reporter->getFailed() > 0 );
+    CHECK( reporter->getFailed() <= 2 );
+
+    // Nor can a SECTION be - otherwise the first thread to reach it would
+    // take it, and every other value would skip it
+    SelfTestReporter* sectionsReporter = new SelfTestReporter();
+    config.setReporter( sectionsReporter );
+    {
+        Runner runner( config );
+        runner.runMatching( "./succeeding/generators/conditionalSections" );
+    }
+    CHECK( sectionsReporter->getFailed() > 0 );
+    CHECK( sectionsReporter->getFailed() <= 2 );
+}
+
+TEST_CASE( "selftest/reporters/multi", "Every reporter given sees every event, each writing to its own output" )
+{
+    using namespace Catch;
+
+    std::ostringstream oss;
+    {
+        Config config;
+        config.setStreamBuf( oss.rdbuf() );
+        config.setIncludeWhat( Config::Include::SuccessfulResults );
+        config.setRngSeed( 1234 );
+        config.setReporter( "xml" );
+        config.setReporter( "junit" );
+        config.setFilename( "selfTestJunit.xml" );
+        REQUIRE( config.getMessage().empty() );
+        runGroup( config, "./mixed/*" );
+        config.setStreamBuf( NULL );
+    }
+    std::string junit = readFile( "selfTestJunit.xml" );
+    std::remove( "selfTestJunit.xml" );
+
+    CHECK( oss.str() == reportOf( "xml", "./mixed/*" ) );
+    CHECK( junit == reportOf( "junit", "./mixed/*" ) );
+}
+
+TEST_CASE( "selftest/abortAfter", "No more test cases are started once enough assertions have failed" )
+{
+    using namespace Catch;
+
+    EmbeddedRunner allRunner;
+    std::size_t allTests = allRunner.runMatching( "./failing/*" );
+
+    SelfTestReporter* reporter = new SelfTestReporter();
+    Config config;
+    config.setReporter( reporter );
+    config.setAbortAfter( 2 );
+    std::size_t testsRun = 0;
+    {
+        Runner runner( config );
+        testsRun = runner.runMatching( "./failing/*" );
+    }
+    CHECK( testsRun > 0 );
+    CHECK( testsRun < allTests );
+    CHECK( reporter->getFailed() >= 2 );
+    CHECK( reporter->getFailed() < allRunner.getReporter().getFailed() );
+}
+
+TEST_CASE( "selftest/order/random", "A random order is the same for the same seed, and differs for another" )
+{
+    std::string order = randomOrderOf( "./succeeding/*", 1234 );
+    REQUIRE( !order.empty() );
+    CHECK( randomOrderOf( "./succeeding/*", 1234 ) == order );
+    CHECK( randomOrderOf( "./succeeding/*", 4321 ) != order );
+}
+
+TEST_CASE( "selftest/repeat", "Repeated test cases report how many of their iterations failed" )
+{
+    using namespace Catch;
+
+    std::ostringstream failingOss;
+    {
+        Config config;
+        config.setStreamBuf( failingOss.rdbuf() );
+        config.setRepeatCount( 5 );
+        config.setReporter( "xml" );
+        runGroup( config, "./failing/message/fail" );
+        config.setStreamBuf( NULL );
+    }
+    CHECK( failingOss.str().find( "Failed in 5 of 5 iteration(s) (100%)" ) != std::string::npos );
+
+    std::ostringstream succeedingOss;
+    {
+        Config config;
+        config.setStreamBuf( succeedingOss.rdbuf() );
+        config.setIncludeWhat( Config::Include::SuccessfulResults );
+        config.setRepeatCount( 5 );
+        config.setReporter( "xml" );
+        runGroup( config, "./succeeding/Misc/Sections" );
+        config.setStreamBuf( NULL );
+    }
+    CHECK( succeedingOss.str().find( "Passed all 5 iteration(s)" ) != std::string::npos );
+}
+
+TEST_CASE( "selftest/list/escapes", "Lists \"quotes\", <angles> & ampersands,\ta tab and a \x01 control character" )
+{
+    using namespace Catch;
+
+    Config config;
+    config.setListSpec( static_cast<Config::List::What>( Config::List::Tests | Config::List::AsXml ) );
+    std::ostringstream xml;
+    Detail::listAsXml( config, NULL, xml );
+    CHECK( xml.str().find( "description=\"Lists &quot;quotes&quot;, &lt;angles> &amp; ampersands,&#x9;a tab and a \\x01 control character\"" ) != std::string::npos );
+
+    config.setListSpec( static_cast<Config::List::What>( Config::List::Tests | Config::List::AsJson ) );
+    std::ostringstream json;
+    Detail::listAsJson( config, NULL, json );
+    CHECK( json.str().find( "\"description\": \"Lists \\\"quotes\\\", <angles> & ampersands,\\ta tab and a \\u0001 control character\"" ) != std::string::npos );
+}
+
+TEST_CASE( "selftest/runners/concurrent", "Threads started by a test report to the run that started them" )
+{
+    using namespace Catch;
+
+    ConcurrentRuns runs;
+    ConcurrentRun run1( runs, 0 ), run2( runs, 1 );
+    {
+        Thread thread1( run1 ), thread2( run2 );
+    }
+    CHECK( run1.m_succeeded == 100 );
+    CHECK( run2.m_succeeded == 100 );
 }
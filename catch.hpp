@@ -15,8 +15,7 @@
  Next:
 
  Later:
-    Finish command line parser (list as xml, specify FP tolerance)
-    Revisit Approx()
+    Finish command line parser (list as xml)
     Tags?
     Finish macros, listed here, later (just CHECK_NOFAIL now)
  */
@@ -28,6 +27,7 @@
 #include "internal/catch_capture.hpp"
 #include "internal/catch_section.hpp"
 #include "internal/catch_generators.hpp"
+#include "internal/catch_property.hpp"
 
 //////
 
@@ -54,17 +54,25 @@
 
 #define TEST_CASE( name, description ) INTERNAL_CATCH_TESTCASE( name, description )
 #define TEST_CASE_NORETURN( name, description ) INTERNAL_CATCH_TESTCASE_NORETURN( name, description )
+#define TEST_CASE_TIMEOUT( name, description, seconds ) INTERNAL_CATCH_TESTCASE_TIMEOUT( name, description, seconds )
 #define ANON_TEST_CASE() INTERNAL_CATCH_TESTCASE( "", "Anonymous test case" )
 #define METHOD_AS_TEST_CASE( method, name, description ) CATCH_METHOD_AS_TEST_CASE( method, name, description )
 
 #define REGISTER_REPORTER( name, reporterType ) INTERNAL_CATCH_REGISTER_REPORTER( name, reporterType )
 
 #define GENERATE( expr) INTERNAL_CATCH_GENERATE( expr )
+#define PROPERTY( name, description, type, var, generator ) INTERNAL_CATCH_PROPERTY( name, description, type, var, generator )
 
 ///////////////
 // Still to be implemented
 #define CHECK_NOFAIL( expr ) // !TBD - reports violation, but doesn't fail Test
 
+namespace Catch
+{
+    // Runs the tests as specified by the command line - see catch_with_main.hpp
+    int Main( int argc, char * const argv[] );
+}
+
 using Catch::Approx;
 
 #endif // TWOBLUECUBES_CATCH_HPP_INCLUDED
\ No newline at end of file
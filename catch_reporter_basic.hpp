@@ -63,6 +63,8 @@ namespace Catch
         ()
         {
             m_config.stream() << "[Started testing]" << std::endl;
+            if( m_config.rngSeed() != 0 )
+                m_config.stream() << "[Randomness seeded to: " << m_config.rngSeed() << "]" << std::endl;
         }
 
         ///////////////////////////////////////////////////////////////////////////
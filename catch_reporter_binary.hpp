@@ -0,0 +1,213 @@
+/*
+ *  catch_reporter_binary.hpp
+ *  Catch
+ *
+ *  Created by the Catch contributors on 19/10/2026.
+ *  Copyright 2026 the Catch contributors. All rights reserved.
+ *
+ *  Distributed under the Boost Software License, Version 1.0. (See accompanying
+ *  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ *
+ */
+#ifndef TWOBLUECUBES_CATCH_REPORTER_BINARY_HPP_INCLUDED
+#define TWOBLUECUBES_CATCH_REPORTER_BINARY_HPP_INCLUDED
+
+#include "internal/catch_capture.hpp"
+#include "internal/catch_interfaces_reporter.h"
+#include "internal/catch_reporter_registrars.hpp"
+#include "internal/catch_binary_log.hpp"
+
+#ifdef _WIN32
+    #include <io.h>
+    #include <fcntl.h>
+    #include <cstdio>
+#endif
+
+namespace Catch
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // Stops the console translating line endings in what is written to it
+    inline void setStdoutBinary
+    ()
+    {
+#ifdef _WIN32
+        std::cout.flush();
+        _setmode( _fileno( stdout ), _O_BINARY );
+#endif
+    }
+
+    class BinaryReporter : public IReporter
+    {
+    public:
+        ///////////////////////////////////////////////////////////////////////////
+        BinaryReporter
+        (
+            const IReporterConfig& config
+        )
+        :   m_config( config ),
+            m_writer( config.stream() )
+        {
+        }
+
+        ///////////////////////////////////////////////////////////////////////////
+        static std::string getDescription
+        ()
+        {
+            return "Writes a compact binary event log. Use --convert to turn it into another format";
+        }
+
+    private: // IReporter
+
+        ///////////////////////////////////////////////////////////////////////////
+        virtual void StartTesting
+        ()
+        {
+            // Nothing has been written yet - the log is buffered
+            if( m_config.stream().rdbuf() == std::cout.rdbuf() )
+                setStdoutBinary();
+            m_writer.beginRecord( BinaryLog::StartTesting );
+            m_writer.writeInt( m_config.rngSeed() );
+            m_writer.endRecord();
+        }
+
+        ///////////////////////////////////////////////////////////////////////////
+        virtual void EndTesting
+        (
+            std::size_t succeeded,
+            std::size_t failed
+        )
+        {
+            m_writer.beginRecord( BinaryLog::EndTesting );
+            m_writer.writeCount( succeeded );
+            m_writer.writeCount( failed );
+            m_writer.endRecord();
+            m_writer.flush();
+        }
+
+        ///////////////////////////////////////////////////////////////////////////
+        virtual void StartGroup
+        (
+            const std::string& groupName
+        )
+        {
+            unsigned int nameId = m_writer.intern( groupName );
+            m_writer.beginRecord( BinaryLog::StartGroup );
+            m_writer.writeInt( nameId );
+            m_writer.endRecord();
+        }
+
+        ///////////////////////////////////////////////////////////////////////////
+        virtual void EndGroup
+        (
+            const std::string& groupName,
+            std::size_t succeeded,
+            std::size_t failed
+        )
+        {
+            unsigned int nameId = m_writer.intern( groupName );
+            m_writer.beginRecord( BinaryLog::EndGroup );
+            m_writer.writeInt( nameId );
+            m_writer.writeCount( succeeded );
+            m_writer.writeCount( failed );
+            m_writer.endRecord();
+        }
+
+        ///////////////////////////////////////////////////////////////////////////
+        virtual void StartSection
+        (
+            const std::string& sectionName,
+            const std::string description
+        )
+        {
+            unsigned int nameId = m_writer.intern( sectionName );
+            m_writer.beginRecord( BinaryLog::StartSection );
+            m_writer.writeInt( nameId );
+            m_writer.writeString( description );
+            m_writer.endRecord();
+        }
+
+        ///////////////////////////////////////////////////////////////////////////
+        virtual void EndSection
+        (
+            const std::string& sectionName,
+            std::size_t succeeded,
+            std::size_t failed
+        )
+        {
+            unsigned int nameId = m_writer.intern( sectionName );
+            m_writer.beginRecord( BinaryLog::EndSection );
+            m_writer.writeInt( nameId );
+            m_writer.writeCount( succeeded );
+            m_writer.writeCount( failed );
+            m_writer.endRecord();
+        }
+
+        ///////////////////////////////////////////////////////////////////////////
+        virtual void StartTestCase
+        (
+            const TestCaseInfo& testInfo
+        )
+        {
+            unsigned int nameId = m_writer.intern( testInfo.getName() );
+            unsigned int descriptionId = m_writer.intern( testInfo.getDescription() );
+            m_writer.beginRecord( BinaryLog::StartTestCase );
+            m_writer.writeInt( nameId );
+            m_writer.writeInt( descriptionId );
+            m_writer.endRecord();
+        }
+
+        ///////////////////////////////////////////////////////////////////////////
+        virtual void Result
+        (
+            const ResultInfo& resultInfo
+        )
+        {
+            if( !m_config.includeSuccessfulResults() && resultInfo.getResultType() == ResultWas::Ok )
+                return;
+
+            unsigned int filenameId = m_writer.intern( resultInfo.getFilename() );
+            unsigned int macroNameId = m_writer.intern( resultInfo.getTestMacroName() );
+            unsigned int exprId = m_writer.intern( resultInfo.getExpression() );
+
+            m_writer.beginRecord( BinaryLog::Result );
+            m_writer.writeInt( static_cast<unsigned int>( resultInfo.getResultType() ) );
+            m_writer.writeInt( filenameId );
+            m_writer.writeInt( static_cast<unsigned int>( resultInfo.getLine() ) );
+            m_writer.writeInt( macroNameId );
+            m_writer.writeInt( exprId );
+
+            // Only store the expansion if it adds something to the original
+            std::string expanded = resultInfo.getExpandedExpression();
+            m_writer.writeString( expanded == resultInfo.getExpression() ? std::string() : expanded );
+            m_writer.writeString( resultInfo.getMessage() );
+            m_writer.endRecord();
+        }
+
+        ///////////////////////////////////////////////////////////////////////////
+        virtual void EndTestCase
+        (
+            const TestCaseInfo& /*testInfo*/,
+            std::size_t succeeded,
+            std::size_t failed,
+            const std::string& stdOut,
+            const std::string& stdErr
+        )
+        {
+            m_writer.beginRecord( BinaryLog::EndTestCase );
+            m_writer.writeCount( succeeded );
+            m_writer.writeCount( failed );
+            m_writer.writeString( stdOut );
+            m_writer.writeString( stdErr );
+            m_writer.endRecord();
+        }
+
+    private:
+        const IReporterConfig& m_config;
+        BinaryLogWriter m_writer;
+    };
+
+    INTERNAL_CATCH_REGISTER_REPORTER( "binary", BinaryReporter );
+
+} // end namespace Catch
+
+#endif // TWOBLUECUBES_CATCH_REPORTER_BINARY_HPP_INCLUDED
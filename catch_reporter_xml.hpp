@@ -46,6 +46,8 @@ namespace Catch
         {
             m_xml = XmlWriter( m_config.stream() );
             m_xml.startElement( "AllTests" );
+            if( m_config.rngSeed() != 0 )
+                m_xml.writeAttribute( "rng-seed", m_config.rngSeed() );
         }
         
         ///////////////////////////////////////////////////////////////////////////
@@ -58,6 +60,7 @@ namespace Catch
             m_xml.scopedElement( "OverallResults" )
                 .writeAttribute( "successes", succeeded )
                 .writeAttribute( "failures", failed );
+            m_xml.endElement();
         }
         
         ///////////////////////////////////////////////////////////////////////////
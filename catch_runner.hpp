@@ -17,16 +17,25 @@
 
 #include "internal/catch_commandline.hpp"
 #include "internal/catch_list.hpp"
+#include "internal/catch_convert.hpp"
 #include "catch_reporter_basic.hpp"
 #include "catch_reporter_xml.hpp"
 #include "catch_reporter_junit.hpp"
+#include "catch_reporter_binary.hpp"
+#include "internal/catch_reporter_async.hpp"
 
 #include <fstream>
 #include <stdlib.h>
+#include <ctime>
 
 namespace Catch
 {
-    inline int Main( int argc, char * const argv[] )
+    // Not inline, so there's one to call from your own main() when the
+    // implementation is built with CATCH_CONFIG_IMPL_ONLY. Like the rest of
+    // the implementation (catch_hub_impl.hpp and the *_impl.hpp files it
+    // includes) it is defined here, so only one file in a program may
+    // include catch_runner.hpp - or catch_with_main.hpp
+    int Main( int argc, char * const argv[] )
     {
         Config config;
         ArgParser( argc, argv, config );
@@ -48,12 +57,25 @@ namespace Catch
             }
             
             std::cout   << exeName << " is a CATCH host application. Options are as follows:\n\n"
-                        << "\t-l, --list <tests | reporters> [xml]\n"
+                        << "\t-l, --list <tests | reporters> [xml | json]\n"
                         << "\t-t, --test <testspec> [<testspec>...]\n"
-                        << "\t-r, --reporter <reporter name>\n"
+                        << "\t-r, --reporter <reporter name> (may be repeated)\n"
                         << "\t-o, --out <file name>|<%stream name>\n"
                         << "\t-s, --success\n"
-                        << "\t-b, --break\n\n"
+                        << "\t-b, --break\n"
+                        << "\t-a, --abort-after [number of failures]\n"
+                        << "\t--convert <binary log file>\n"
+                        << "\t--async [max queued events]\n"
+                        << "\t--timeout <seconds>\n"
+                        << "\t--state <file name>\n"
+                        << "\t--rerun-failed\n"
+                        << "\t--cache-dir <directory> [--cache-key <build fingerprint>] [--cache-refresh]\n"
+                        << "\t--order <decl | lex | rand>\n"
+                        << "\t--rng-seed <seed>\n"
+                        << "\t--repeat <number of times> [--until-failure]\n"
+                        << "\t--combine <all | pairwise>\n"
+                        << "\t--generator-threads <number of threads>\n"
+                        << "\t--fp-tolerance <epsilon>\n\n"
                         << "For more detail usage please see: https://github.com/philsquared/Catch/wiki/Command-line" << std::endl;
             return 0;
         }
@@ -62,11 +84,29 @@ namespace Catch
         if( config.listWhat() != Config::List::None )
             return List( config );
         
+        // Select the test cases that failed last time, from the state file
+        std::vector<std::string> failedTests;
+        if( config.shouldRerunFailed() )
+        {
+            RunState state;
+            if( config.getStateFilename().empty() || !state.load( config.getStateFilename() ) )
+            {
+                std::cerr << "--rerun-failed needs a readable state file, from --state <file name>" << std::endl;
+                return std::numeric_limits<int>::max();
+            }
+            failedTests = state.getFailedTestNames();
+            if( failedTests.empty() )
+            {
+                std::cout << "No failed test cases recorded in: '" << config.getStateFilename() << "'" << std::endl;
+                return 0;
+            }
+        }
+        
         // Open output file, if specified
         std::ofstream ofs;
         if( !config.getFilename().empty() )
         {
-            ofs.open( config.getFilename().c_str() );
+            ofs.open( config.getFilename().c_str(), config.isBinaryOutput() ? std::ios::out | std::ios::binary : std::ios::out );
             if( ofs.fail() )
             {
                 std::cerr << "Unable to open file: '" << config.getFilename() << "'" << std::endl;
@@ -75,14 +115,40 @@ namespace Catch
             config.setStreamBuf( ofs.rdbuf() );
         }
 
+        // Handle conversion of a binary log into the chosen reporter's format
+        if( !config.getConvertFilename().empty() )
+            return Convert( config );
+
+        // Fingerprint the build for the result cache, unless the build provided one
+        if( !config.getCacheDir().empty() && config.getBuildFingerprint().empty() )
+        {
+            unsigned long long hash = 0;
+            if( !hashFile( "/proc/self/exe", hash ) && !hashFile( argv[0], hash ) )
+            {
+                std::cerr << "Unable to read the test executable to fingerprint it - use --cache-key" << std::endl;
+                return std::numeric_limits<int>::max();
+            }
+            config.setBuildFingerprint( toHex( hash ) );
+        }
+
+        // Pick a fresh seed for each run - for a random order, random generators
+        // and properties - unless asked to reproduce an earlier one. It is
+        // printed for a random order, or with any failing test that used it,
+        // so a failure can be reproduced with --rng-seed
+        if( !config.isRngSeedGiven() )
+            config.chooseRngSeed( static_cast<unsigned int>( std::time( NULL ) ) );
+
+        if( config.getAsyncQueueSize() > 0 )
+            config.setReporter( new AsyncReporter( config.releaseReporter(), config.getAsyncQueueSize() ) );
+
         Runner runner( config );
 
         // Run test specs specified on the command line - or default to all
-        if( !config.testsSpecified() )
+        if( !config.testsSpecified() && failedTests.empty() )
         {
-            config.getReporter()->StartGroup( "" );
+            runner.startGroup( "" );
             runner.runAll();
-            config.getReporter()->EndGroup( "", runner.getSuccessCount(), runner.getFailureCount() );
+            runner.endGroup();
         }
         else
         {
@@ -90,17 +156,23 @@ namespace Catch
             // then just run them
             std::vector<std::string>::const_iterator it = config.getTestSpecs().begin();
             std::vector<std::string>::const_iterator itEnd = config.getTestSpecs().end();
-            for(; it != itEnd; ++it )
+            for(; it != itEnd && !runner.aborting(); ++it )
             {
-                size_t prevSuccess = runner.getSuccessCount();
-                size_t prevFail = runner.getFailureCount();
-                config.getReporter()->StartGroup( *it );
+                runner.startGroup( *it );
                 if( runner.runMatching( *it ) == 0 )
                 {
                     // Use reporter?
 //                    std::cerr << "\n[Unable to match any test cases with: " << *it << "]" << std::endl;
                 }
-                config.getReporter()->EndGroup( *it, runner.getSuccessCount()-prevSuccess, runner.getFailureCount()-prevFail );
+                runner.endGroup();
+            }
+            // The names of failed tests are matched exactly, not as test specs
+            // - a name may well end in '*'
+            for( std::size_t i = 0; i < failedTests.size() && !runner.aborting(); ++i )
+            {
+                runner.startGroup( failedTests[i] );
+                runner.runNamed( failedTests[i] );
+                runner.endGroup();
             }
         }
         return runner.getFailureCount();
@@ -15,9 +15,21 @@
 #include "catch_runner.hpp"
 #include "catch.hpp"
 
+// Define CATCH_CONFIG_IMPL_ONLY for just the implementation, without main().
+// It only ever needs compiling once, so it can live in a file (or library)
+// of its own, outside the edit-compile cycle of the test files - which only
+// need catch.hpp:
+//
+//     // catch_impl.cpp
+//     #define CATCH_CONFIG_IMPL_ONLY
+//     #include "catch_with_main.hpp"
+//
+// Your own main() then calls Catch::Main( argc, argv )
+#ifndef CATCH_CONFIG_IMPL_ONLY
 int main (int argc, char * const argv[])
 {
     return Catch::Main( argc, argv );
 }
+#endif
 
 #endif // TWOBLUECUBES_CATCH_WITH_MAIN_HPP_INCLUDED
\ No newline at end of file
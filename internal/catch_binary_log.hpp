@@ -0,0 +1,478 @@
+/*
+ *  catch_binary_log.hpp
+ *  Catch
+ *
+ *  Created by the Catch contributors on 19/10/2026.
+ *  Copyright 2026 the Catch contributors. All rights reserved.
+ *
+ *  Distributed under the Boost Software License, Version 1.0. (See accompanying
+ *  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ *
+ * A compact, length-prefixed event stream that can be replayed into any
+ * reporter later on. Every record is: [type:1][payload length:4][payload].
+ * Strings that recur (test names, filenames, expressions, macro names) are
+ * interned - written once as a String record and referred to by id thereafter
+ */
+#ifndef TWOBLUECUBES_CATCH_BINARY_LOG_HPP_INCLUDED
+#define TWOBLUECUBES_CATCH_BINARY_LOG_HPP_INCLUDED
+
+#include "catch_interfaces_reporter.h"
+#include "catch_interfaces_testcase.h"
+#include "catch_config.hpp"
+#include "catch_test_case_info.hpp"
+#include "catch_resultinfo.hpp"
+
+#include <istream>
+#include <ostream>
+#include <string>
+#include <vector>
+#include <map>
+#include <cstring>
+#include <algorithm>
+
+namespace Catch
+{
+    struct BinaryLog
+    {
+        enum RecordType
+        {
+            String = 1,
+            StartTesting,
+            EndTesting,
+            StartGroup,
+            EndGroup,
+            StartSection,
+            EndSection,
+            StartTestCase,
+            EndTestCase,
+            Result
+        };
+
+        static const char* magic(){ return "CATCHBIN"; }
+        // Version 2 records the rng seed of the run in StartTesting
+        enum { magicSize = 8, version = 2, headerSize = 5, maxRecordSize = 64*1024*1024 };
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    ///////////////////////////////////////////////////////////////////////////
+
+    class BinaryLogWriter : NonCopyable
+    {
+    public:
+        ///////////////////////////////////////////////////////////////////////
+        explicit BinaryLogWriter
+        (
+            std::ostream& os,
+            std::size_t flushThreshold = 64*1024
+        )
+        :   m_os( os ),
+            m_flushThreshold( flushThreshold ),
+            m_recordStart( 0 )
+        {
+            m_buffer.reserve( flushThreshold + 1024 );
+            m_buffer.insert( m_buffer.end(), BinaryLog::magic(), BinaryLog::magic() + BinaryLog::magicSize );
+            m_buffer.push_back( static_cast<char>( BinaryLog::version ) );
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        ~BinaryLogWriter
+        ()
+        {
+            flush();
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // Interns the string, emitting a String record the first time it is seen
+        unsigned int intern
+        (
+            const std::string& str
+        )
+        {
+            std::map<std::string, unsigned int>::const_iterator it = m_ids.find( str );
+            if( it != m_ids.end() )
+                return it->second;
+
+            unsigned int id = static_cast<unsigned int>( m_ids.size() );
+            m_ids.insert( std::make_pair( str, id ) );
+            beginRecord( BinaryLog::String );
+            writeInt( id );
+            writeBytes( str.c_str(), str.size() );
+            endRecord();
+            return id;
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        void beginRecord
+        (
+            BinaryLog::RecordType type
+        )
+        {
+            m_recordStart = m_buffer.size();
+            m_buffer.push_back( static_cast<char>( type ) );
+            writeInt( 0 ); // length - patched in endRecord()
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        void endRecord
+        ()
+        {
+            std::size_t length = m_buffer.size() - m_recordStart - BinaryLog::headerSize;
+            encodeInt( &m_buffer[m_recordStart+1], static_cast<unsigned int>( length ) );
+            if( m_buffer.size() >= m_flushThreshold )
+                flush();
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        void writeInt
+        (
+            unsigned int value
+        )
+        {
+            char bytes[4];
+            encodeInt( bytes, value );
+            m_buffer.insert( m_buffer.end(), bytes, bytes+4 );
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        void writeCount
+        (
+            std::size_t value
+        )
+        {
+            writeInt( static_cast<unsigned int>( value & 0xffffffff ) );
+            writeInt( static_cast<unsigned int>( ( static_cast<unsigned long long>( value ) >> 32 ) & 0xffffffff ) );
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // Non-interned strings are written inline, with a length prefix
+        void writeString
+        (
+            const std::string& str
+        )
+        {
+            writeInt( static_cast<unsigned int>( str.size() ) );
+            writeBytes( str.c_str(), str.size() );
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        void flush
+        ()
+        {
+            if( !m_buffer.empty() )
+            {
+                m_os.write( &m_buffer[0], static_cast<std::streamsize>( m_buffer.size() ) );
+                m_buffer.clear();
+            }
+            m_os.flush();
+        }
+
+    private:
+        ///////////////////////////////////////////////////////////////////////
+        void writeBytes
+        (
+            const char* data,
+            std::size_t size
+        )
+        {
+            m_buffer.insert( m_buffer.end(), data, data+size );
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        static void encodeInt
+        (
+            char* bytes,
+            unsigned int value
+        )
+        {
+            // Always little-endian, so logs can be moved between machines
+            bytes[0] = static_cast<char>( value & 0xff );
+            bytes[1] = static_cast<char>( ( value >> 8 ) & 0xff );
+            bytes[2] = static_cast<char>( ( value >> 16 ) & 0xff );
+            bytes[3] = static_cast<char>( ( value >> 24 ) & 0xff );
+        }
+
+        std::ostream& m_os;
+        std::size_t m_flushThreshold;
+        std::size_t m_recordStart;
+        std::vector<char> m_buffer;
+        std::map<std::string, unsigned int> m_ids;
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    ///////////////////////////////////////////////////////////////////////////
+
+    // Stands in for the original test function when replaying a log
+    struct ReplayedTestCase : ITestCase
+    {
+        virtual void invoke() const {}
+        virtual ITestCase* clone() const { return new ReplayedTestCase(); }
+        virtual bool operator == ( const ITestCase& other ) const { return dynamic_cast<const ReplayedTestCase*>( &other ) != NULL; }
+        virtual bool operator < ( const ITestCase& ) const { return false; }
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    class ReplayedResultInfo : public ResultInfo
+    {
+    public:
+        ///////////////////////////////////////////////////////////////////////
+        ReplayedResultInfo
+        (
+            const std::string& expr,
+            ResultWas::OfType result,
+            const std::string& filename,
+            std::size_t line,
+            const std::string& macroName,
+            const std::string& expandedExpr,
+            const std::string& message
+        )
+        :   ResultInfo( expr.c_str(), result, false, filename.c_str(), line, macroName.c_str() )
+        {
+            setExpressionString( expandedExpr );
+            setMessage( message );
+        }
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    ///////////////////////////////////////////////////////////////////////////
+
+    class BinaryLogReader : NonCopyable
+    {
+    public:
+        ///////////////////////////////////////////////////////////////////////
+        explicit BinaryLogReader
+        (
+            std::istream& is
+        )
+        :   m_is( is ),
+            m_pos( 0 ),
+            m_failed( 0 )
+        {
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // Reads the whole log, forwarding every event to the config's reporter.
+        // The config is given the rng seed of the logged run first, so that is
+        // reported too. Returns an empty string on success, or a description
+        // of the problem
+        std::string replay
+        (
+            Config& config
+        )
+        {
+            IReporter& reporter = *config.getReporter();
+            char header[BinaryLog::magicSize+1];
+            if( !m_is.read( header, sizeof( header ) ) ||
+                std::memcmp( header, BinaryLog::magic(), BinaryLog::magicSize ) != 0 )
+                return "Not a Catch binary log";
+            if( header[BinaryLog::magicSize] != BinaryLog::version )
+                return "Unsupported Catch binary log version";
+
+            // A record can't be longer than what is left of the log, so a
+            // corrupt length doesn't get gigabytes allocated for it
+            std::size_t remaining = remainingSize();
+            char recordHeader[BinaryLog::headerSize];
+            while( m_is.read( recordHeader, BinaryLog::headerSize ) )
+            {
+                std::size_t length = decodeInt( recordHeader+1 );
+                remaining -= (std::min)( remaining, static_cast<std::size_t>( BinaryLog::headerSize ) );
+                if( length > remaining )
+                    return "Corrupt Catch binary log";
+                remaining -= length;
+                m_payload.resize( length );
+                if( !m_payload.empty() && !m_is.read( &m_payload[0], static_cast<std::streamsize>( m_payload.size() ) ) )
+                    return "Truncated Catch binary log";
+                m_pos = 0;
+                if( !dispatch( static_cast<BinaryLog::RecordType>( recordHeader[0] ), reporter, config ) )
+                    return "Corrupt Catch binary log";
+            }
+            return "";
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // The number of failed assertions in the replayed run
+        std::size_t getFailureCount
+        ()
+        const
+        {
+            return m_failed;
+        }
+
+    private:
+        ///////////////////////////////////////////////////////////////////////
+        // The number of bytes after the current position - or, if the stream
+        // can't tell, the most a record may have
+        std::size_t remainingSize
+        ()
+        {
+            std::streampos pos = m_is.tellg();
+            if( pos != std::streampos( -1 ) && m_is.seekg( 0, std::ios::end ) )
+            {
+                std::streamoff size = m_is.tellg() - pos;
+                m_is.seekg( pos );
+                if( size >= 0 )
+                    return static_cast<std::size_t>( size );
+            }
+            m_is.clear();
+            return BinaryLog::maxRecordSize;
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        bool dispatch
+        (
+            BinaryLog::RecordType type,
+            IReporter& reporter,
+            Config& config
+        )
+        {
+            switch( type )
+            {
+                case BinaryLog::String:
+                {
+                    unsigned int id = readInt();
+                    if( id != m_strings.size() )
+                        return false;
+                    m_strings.push_back( std::string( m_payload.begin() + m_pos, m_payload.end() ) );
+                    m_pos = m_payload.size();
+                    break;
+                }
+                case BinaryLog::StartTesting:
+                    config.setRngSeed( readInt() );
+                    reporter.StartTesting();
+                    break;
+                case BinaryLog::EndTesting:
+                {
+                    std::size_t succeeded = readCount();
+                    m_failed = readCount();
+                    reporter.EndTesting( succeeded, m_failed );
+                    break;
+                }
+                case BinaryLog::StartGroup:
+                    reporter.StartGroup( readInterned() );
+                    break;
+                case BinaryLog::EndGroup:
+                {
+                    const std::string& name = readInterned();
+                    std::size_t succeeded = readCount();
+                    std::size_t failed = readCount();
+                    reporter.EndGroup( name, succeeded, failed );
+                    break;
+                }
+                case BinaryLog::StartSection:
+                {
+                    const std::string& name = readInterned();
+                    reporter.StartSection( name, readString() );
+                    break;
+                }
+                case BinaryLog::EndSection:
+                {
+                    const std::string& name = readInterned();
+                    std::size_t succeeded = readCount();
+                    std::size_t failed = readCount();
+                    reporter.EndSection( name, succeeded, failed );
+                    break;
+                }
+                case BinaryLog::StartTestCase:
+                {
+                    const std::string& name = readInterned();
+                    const std::string& description = readInterned();
+                    m_testCase = TestCaseInfo( new ReplayedTestCase(), name.c_str(), description.c_str() );
+                    reporter.StartTestCase( m_testCase );
+                    break;
+                }
+                case BinaryLog::EndTestCase:
+                {
+                    std::size_t succeeded = readCount();
+                    std::size_t failed = readCount();
+                    std::string stdOut = readString();
+                    std::string stdErr = readString();
+                    reporter.EndTestCase( m_testCase, succeeded, failed, stdOut, stdErr );
+                    break;
+                }
+                case BinaryLog::Result:
+                {
+                    ResultWas::OfType resultType = static_cast<ResultWas::OfType>( static_cast<int>( readInt() ) );
+                    const std::string& filename = readInterned();
+                    std::size_t line = readInt();
+                    const std::string& macroName = readInterned();
+                    const std::string& expr = readInterned();
+                    std::string expandedExpr = readString();
+                    std::string message = readString();
+                    reporter.Result( ReplayedResultInfo( expr, resultType, filename, line, macroName, expandedExpr, message ) );
+                    break;
+                }
+                default:
+                    return false;
+            }
+            return m_pos <= m_payload.size();
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        unsigned int readInt
+        ()
+        {
+            if( m_pos + 4 > m_payload.size() )
+            {
+                m_pos = m_payload.size()+1;
+                return 0;
+            }
+            unsigned int value = decodeInt( &m_payload[m_pos] );
+            m_pos += 4;
+            return value;
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        std::size_t readCount
+        ()
+        {
+            unsigned long long low = readInt();
+            unsigned long long high = readInt();
+            return static_cast<std::size_t>( low | ( high << 32 ) );
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        const std::string& readInterned
+        ()
+        {
+            static const std::string unknown;
+            unsigned int id = readInt();
+            return id < m_strings.size() ? m_strings[id] : unknown;
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        std::string readString
+        ()
+        {
+            std::size_t size = readInt();
+            if( m_pos + size > m_payload.size() )
+            {
+                m_pos = m_payload.size()+1;
+                return "";
+            }
+            std::string str( m_payload.begin() + m_pos, m_payload.begin() + m_pos + size );
+            m_pos += size;
+            return str;
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        static unsigned int decodeInt
+        (
+            const char* bytes
+        )
+        {
+            return  static_cast<unsigned int>( static_cast<unsigned char>( bytes[0] ) ) |
+                    static_cast<unsigned int>( static_cast<unsigned char>( bytes[1] ) ) << 8 |
+                    static_cast<unsigned int>( static_cast<unsigned char>( bytes[2] ) ) << 16 |
+                    static_cast<unsigned int>( static_cast<unsigned char>( bytes[3] ) ) << 24;
+        }
+
+        std::istream& m_is;
+        std::vector<char> m_payload;
+        std::size_t m_pos;
+        std::vector<std::string> m_strings;
+        std::size_t m_failed;
+        TestCaseInfo m_testCase;
+    };
+
+} // end namespace Catch
+
+#endif // TWOBLUECUBES_CATCH_BINARY_LOG_HPP_INCLUDED
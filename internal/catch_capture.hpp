@@ -18,22 +18,84 @@
 #include "catch_debugger.hpp"
 #include <sstream>
 #include <cmath>
+#include <new>
+#include <utility>
+#include <vector>
 
 namespace Catch
 {
+// The most elements of a container that are written out - the rest are just
+// counted, so huge containers don't give huge failure messages
+#ifndef CATCH_CONFIG_MAX_CONTAINER_ELEMENTS
+#define CATCH_CONFIG_MAX_CONTAINER_ELEMENTS 32
+#endif
+
+template<typename T>
+std::string toString( const T& value );
+
+// Shortcut overloads. Those for the builtin types format into a buffer on the
+// stack rather than going through a stream, and are defined (once) in
+// catch_capture_impl.hpp
+
+///////////////////////////////////////////////////////////////////////////////
+inline std::string toString
+(
+    const std::string& value
+)
+{
+    return value;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+inline std::string toString
+(
+    const char* value
+)
+{
+    return value;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+inline std::string toString
+(
+    char* value
+)
+{
+    return value;
+}
+
+std::string toString( bool value );
+std::string toString( char value );
+std::string toString( signed char value );
+std::string toString( unsigned char value );
+std::string toString( short value );
+std::string toString( unsigned short value );
+std::string toString( int value );
+std::string toString( unsigned int value );
+std::string toString( long value );
+std::string toString( unsigned long value );
+std::string toString( long long value );
+std::string toString( unsigned long long value );
+
+// Floating point values are written with as few digits as will read back as
+// the same value
+std::string toString( float value );
+std::string toString( double value );
+std::string toString( long double value );
+
 namespace Detail
 {
     // The following code, contributed by Sam Partington, allows us to choose an implementation
     // of toString() depending on whether a << overload is available
-    
+
     struct NonStreamable
     {
         // allow construction from anything...
-        template<typename Anything> 
+        template<typename Anything>
         NonStreamable(Anything)
         {}
     };
-    
+
     // a local operator<<  which may be called if there isn't a better one elsewhere...
     inline NonStreamable operator << ( std::ostream&, const NonStreamable& ns )
     {
@@ -48,11 +110,13 @@ namespace Detail
 
         enum
         {
-            value = sizeof( Deduce( Synth<std::ostream&>() << Synth<const T&>() ) ) 
+            value = sizeof( Deduce( Synth<std::ostream&>() << Synth<const T&>() ) )
                         == sizeof( YesType )
         };
     };
-    
+
+    std::string pointerToString( unsigned long long address );
+
     // << is available, so use it with ostringstream to make the string
     template<typename T, bool streamable>
     struct StringMaker
@@ -68,7 +132,7 @@ namespace Detail
             return oss.str();
         }
     };
-      
+
     // << not available - use a default string
     template<typename T>
     struct StringMaker<T, false>
@@ -83,6 +147,59 @@ namespace Detail
         }
     };
 
+    // Pointers are written as addresses, without a stream. Function pointers
+    // included (a stream would write those as "1")
+    template<typename T>
+    struct StringMaker<T*, true>
+    {
+        ///////////////////////////////////////////////////////////////////////
+        static std::string apply
+        (
+            T* value
+        )
+        {
+            return pointerToString( reinterpret_cast<unsigned long long>( value ) );
+        }
+    };
+
+    // Containers with no << of their own are written element by element, up
+    // to CATCH_CONFIG_MAX_CONTAINER_ELEMENTS of them
+    template<typename T, typename Allocator>
+    struct StringMaker<std::vector<T, Allocator>, false>
+    {
+        ///////////////////////////////////////////////////////////////////////
+        static std::string apply
+        (
+            const std::vector<T, Allocator>& value
+        )
+        {
+            std::string str = "{ ";
+            std::size_t i = 0;
+            for( ; i < value.size() && i < CATCH_CONFIG_MAX_CONTAINER_ELEMENTS; ++i )
+            {
+                if( i > 0 )
+                    str += ", ";
+                str += toString( static_cast<const T&>( value[i] ) );
+            }
+            if( i < value.size() )
+                str += " ... and " + toString( value.size() - i ) + " more";
+            return str + ( value.empty() ? "}" : " }" );
+        }
+    };
+
+    template<typename T1, typename T2>
+    struct StringMaker<std::pair<T1, T2>, false>
+    {
+        ///////////////////////////////////////////////////////////////////////
+        static std::string apply
+        (
+            const std::pair<T1, T2>& value
+        )
+        {
+            return "{ " + toString( value.first ) + ", " + toString( value.second ) + " }";
+        }
+    };
+
 }// end namespace Detail
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -94,62 +211,385 @@ std::string toString
 {
     return Detail::StringMaker<T, Detail::IsStreamable<T>::value>::apply( value );
 }
-    
-// Shortcut overloads
 
-///////////////////////////////////////////////////////////////////////////////
-inline std::string toString
-(
-    const std::string& value
-)
+class TestFailureException
 {
-    return value;
+};
+class DummyExceptionType_DontUse
+{
+};
+
+// Collects what is written to a MessageStream, in a string that keeps its
+// capacity from one message to the next
+class MessageStreamBuf : public StreamBufBase
+{
+public:
+    ///////////////////////////////////////////////////////////////////////////
+    const std::string& str
+    ()
+    const
+    {
+        return m_str;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    void clear
+    ()
+    {
+        m_str.clear();
+    }
+
+private:
+    virtual int overflow( int c );
+    virtual std::streamsize xsputn( const char* s, std::streamsize n );
+
+    std::string m_str;
+};
+
+// What INFO, WARN and FAIL messages are written to. Each thread has one,
+// from Hub::getMessageStream(), that is reused for every message - so,
+// unlike a fresh ostringstream each time, it doesn't allocate once it has
+// grown to fit
+class MessageStream : public std::ostream
+{
+public:
+    MessageStream();
+
+    // Empties the stream, and puts its formatting back to the defaults
+    void reset();
+
+    ///////////////////////////////////////////////////////////////////////////
+    const std::string& str
+    ()
+    const
+    {
+        return m_buf.str();
+    }
+
+private:
+    MessageStreamBuf m_buf;
+};
+
+inline double catch_max( double x, double y )
+{
+    return x > y ? x : y;
 }
 
-///////////////////////////////////////////////////////////////////////////////
-inline std::string toString
-(
-    const char* value
-)
+namespace Detail
 {
-    return value;
-}    
+    template<typename T>
+    struct IsFloat
+    {
+        enum { value = false };
+    };
+
+    template<>
+    struct IsFloat<float>
+    {
+        enum { value = true };
+    };
+
+}// end namespace Detail
+
+// Compares floating point values with a tolerance: a difference of up to
+// epsilon() of the larger magnitude, or margin() absolutely, whichever is more
+// - or, if ulps() is given, of up to that many representable values.
+// Either side may also be a range of floats or doubles (a std::vector, or a
+// pointer and a count), compared element by element in one go
+class Approx
+{
+public:
+    ///////////////////////////////////////////////////////////////////////////
+    Approx
+    (
+        double value
+    );
+
+    ///////////////////////////////////////////////////////////////////////////
+    Approx
+    (
+        const std::vector<double>& values
+    );
+
+    ///////////////////////////////////////////////////////////////////////////
+    Approx
+    (
+        const std::vector<float>& values
+    );
+
+    ///////////////////////////////////////////////////////////////////////////
+    Approx
+    (
+        const double* values,
+        std::size_t count
+    );
+
+    ///////////////////////////////////////////////////////////////////////////
+    Approx
+    (
+        const float* values,
+        std::size_t count
+    );
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Relative tolerance. Defaults to the --fp-tolerance option, else 1e-10
+    Approx& epsilon
+    (
+        double newEpsilon
+    )
+    {
+        m_epsilon = newEpsilon;
+        return *this;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Absolute tolerance, for values near zero. Defaults to 1e-10
+    Approx& margin
+    (
+        double newMargin
+    )
+    {
+        m_margin = newMargin;
+        return *this;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Also accept values this many representable values away (in the type
+    // being compared)
+    Approx& ulps
+    (
+        unsigned int newUlps
+    )
+    {
+        m_ulps = newUlps;
+        return *this;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    template<typename T>
+    friend bool operator ==
+    (
+        const T& lhs,
+        const Approx& rhs
+    )
+    {
+        return rhs.matches( static_cast<double>( lhs ), Detail::IsFloat<T>::value );
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    template<typename T>
+    friend bool operator !=
+    (
+        const T& lhs,
+        const Approx& rhs
+    )
+    {
+        return ! operator==( lhs, rhs );
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    friend bool operator ==
+    (
+        const std::vector<double>& lhs,
+        const Approx& rhs
+    )
+    {
+        return rhs.matches( lhs.empty() ? NULL : &lhs[0], lhs.size() );
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    friend bool operator ==
+    (
+        const std::vector<float>& lhs,
+        const Approx& rhs
+    )
+    {
+        return rhs.matches( lhs.empty() ? NULL : &lhs[0], lhs.size() );
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    friend bool operator !=
+    (
+        const std::vector<double>& lhs,
+        const Approx& rhs
+    )
+    {
+        return !( lhs == rhs );
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    friend bool operator !=
+    (
+        const std::vector<float>& lhs,
+        const Approx& rhs
+    )
+    {
+        return !( lhs == rhs );
+    }
+
+    // These, and the constructors, are defined in catch_capture_impl.hpp
+    bool matches
+        (   double value,
+            bool isFloat
+        )
+        const;
+
+    bool matches
+        (   const double* values,
+            std::size_t count
+        )
+        const;
+
+    bool matches
+        (   const float* values,
+            std::size_t count
+        )
+        const;
+
+    std::string describe
+        ()
+        const;
+
+private:
+    bool withinTolerance
+        (   double value,
+            double expected,
+            bool isFloat
+        )
+        const;
+
+    template<typename T>
+    bool matchesRange
+        (   const T* values,
+            std::size_t count
+        )
+        const;
+
+    void setDefaultTolerance
+        ();
+
+    double m_value;
+    std::vector<double> m_values;
+    bool m_isRange;
+    double m_epsilon;
+    double m_margin;
+    unsigned int m_ulps;
+};
 
 ///////////////////////////////////////////////////////////////////////////////
-inline std::string toString
+template<>
+inline std::string toString<Approx>
 (
-    int value
+    const Approx& value
 )
 {
-    std::ostringstream oss;
-    oss << value;
-    return oss.str();
+    return value.describe();
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-inline std::string toString
+// This is just here to avoid compiler warnings with macro constants
+inline bool isTrue
 (
-    const double value 
+    bool value
 )
 {
-    std::ostringstream oss;
-    oss << value;
-    return oss.str();
-}    
-    
-class TestFailureException
+    return value;
+}
+
+namespace Detail
 {
-};
-class DummyExceptionType_DontUse
+    // Operands are handed to the (non-template) result builders as a pointer
+    // and one of these, so building the expression string is shared code
+    // rather than being generated again for every operand type
+    typedef std::string (*OperandStringifier)( const void* operand );
+
+    ///////////////////////////////////////////////////////////////////////////
+    template<typename T>
+    std::string stringifyOperand
+    (
+        const void* operand
+    )
+    {
+        return toString( *static_cast<const T*>( operand ) );
+    }
+
+}// end namespace Detail
+
+namespace Detail
 {
-};
-    
+    // Whether a copy of a value can be kept in a SCOPED_INFO, and only
+    // formatted if something fails - arithmetic values and void pointers can.
+    // Anything else (C strings included) is formatted straight away, as what
+    // it refers to may be a temporary, or may change
+    template<typename T> struct IsDeferrable { enum { value = false }; };
+    template<> struct IsDeferrable<void*> { enum { value = true }; };
+    template<> struct IsDeferrable<const void*> { enum { value = true }; };
+    template<> struct IsDeferrable<bool> { enum { value = true }; };
+    template<> struct IsDeferrable<char> { enum { value = true }; };
+    template<> struct IsDeferrable<signed char> { enum { value = true }; };
+    template<> struct IsDeferrable<unsigned char> { enum { value = true }; };
+    template<> struct IsDeferrable<short> { enum { value = true }; };
+    template<> struct IsDeferrable<unsigned short> { enum { value = true }; };
+    template<> struct IsDeferrable<int> { enum { value = true }; };
+    template<> struct IsDeferrable<unsigned int> { enum { value = true }; };
+    template<> struct IsDeferrable<long> { enum { value = true }; };
+    template<> struct IsDeferrable<unsigned long> { enum { value = true }; };
+    template<> struct IsDeferrable<long long> { enum { value = true }; };
+    template<> struct IsDeferrable<unsigned long long> { enum { value = true }; };
+    template<> struct IsDeferrable<float> { enum { value = true }; };
+    template<> struct IsDeferrable<double> { enum { value = true }; };
+    template<> struct IsDeferrable<long double> { enum { value = true }; };
+
+    template<bool deferrable>
+    struct Deferral
+    {
+    };
+
+}// end namespace Detail
+
+// Context for the assertions made while it is in scope, e.g:
+//     SCOPED_INFO( "row " << row << ", column " << column );
+// It is reported before any of them that fail. Arithmetic values (and void
+// pointers) are copied when the SCOPED_INFO is reached, but only formatted if
+// that happens; anything else - C strings included - is formatted straight
+// away. So it isn't free when nothing fails: formatting allocates, and so
+// does text too long for the small string buffer of m_text
 class ScopedInfo
 {
+    ScopedInfo( const ScopedInfo& );
+    void operator=( const ScopedInfo& );
+
+    enum
+    {
+        MaxParts = 8
+    };
+
+    union Storage
+    {
+        long double f;
+        unsigned long long i;
+        const void* p;
+        std::size_t textRange[2];
+    };
+
+    // A value, and how to format it - or, with no stringifier, a range of
+    // m_text that has been formatted already
+    struct Part
+    {
+        Detail::OperandStringifier stringify;
+        Storage storage;
+    };
+
 public:
     ///////////////////////////////////////////////////////////////////////////
     ScopedInfo
-    ()
+    (
+        const char* filename,
+        std::size_t line
+    )
+    :   m_filename( filename ),
+        m_line( line ),
+        m_partCount( 0 )
     {
         Hub::getResultCapture().pushScopedInfo( this );
     }
@@ -161,126 +601,196 @@ public:
         Hub::getResultCapture().popScopedInfo( this );
     }
     
+    ///////////////////////////////////////////////////////////////////////////
+    template<typename T>
+    ScopedInfo& operator << 
+    (
+        const T& value
+    )
+    {
+        append( value, Detail::Deferral<Detail::IsDeferrable<T>::value>() );
+        return *this;
+    }
+    
     ///////////////////////////////////////////////////////////////////////////
     ScopedInfo& operator << 
     (
         const char* str
     )
     {
-        m_oss << str;
+        appendText( str );
         return *this; 
     }
     
+    std::string getInfo
+        () const;
+    
+    ///////////////////////////////////////////////////////////////////////////
+    const char* getFilename
+    ()
+    const
+    {
+        return m_filename;
+    }
+    
+    ///////////////////////////////////////////////////////////////////////////
+    std::size_t getLine
+    ()
+    const
+    {
+        return m_line;
+    }
+    
+private:
+    ///////////////////////////////////////////////////////////////////////////
+    template<typename T>
+    void append
+    (
+        const T& value,
+        Detail::Deferral<true>
+    )
+    {
+        Part& part = nextPart();
+        new( static_cast<void*>( &part.storage ) ) T( value );
+        part.stringify = &Detail::stringifyOperand<T>;
+    }
+    
+    ///////////////////////////////////////////////////////////////////////////
+    template<typename T>
+    void append
+    (
+        const T& value,
+        Detail::Deferral<false>
+    )
+    {
+        appendText( toString( value ) );
+    }
+    
+    Part& nextPart
+        ();
+    
+    void appendText
+        (   const std::string& text
+        );
+    
+    const char* m_filename;
+    std::size_t m_line;
+    Part m_parts[MaxParts];
+    std::size_t m_partCount;
+    std::string m_text;
+};
+
+// Predeclarations for references in ChunkEvaluator and ReverseChunkEvaluator
+class ResultBuilder;
+class ReverseResultBuilder;
+template<typename LhsT> class ChunkEvaluator;
+template<typename RhsT> class ReverseChunkEvaluator;
+
+// The builders' members that do the string handling are defined in
+// catch_capture_impl.hpp, so they're compiled once rather than at every
+// assertion
+
+class ReverseResultBuilder
+{
+public:
+    ///////////////////////////////////////////////////////////////////////////
+    void prepend
+    (
+        const std::string& exprChunk
+    );
+
+    ///////////////////////////////////////////////////////////////////////////
+    void prependOperand
+    (
+        const void* operand,
+        Detail::OperandStringifier stringify
+    );
+
     ///////////////////////////////////////////////////////////////////////////
-    std::string getInfo
+    const std::string& getExprString
     ()
     const
     {
-        return m_oss.str();
+        return m_exprString;
     }
-    
+
 private:
-    std::ostringstream m_oss;
+    std::string m_exprString;
 };
-    
-    
-// !TBD Need to clean this all up
-#define CATCH_absTol 1e-10
-#define CATCH_relTol 1e-10
 
-inline double catch_max( double x, double y )
-{
-    return x > y ? x : y;
-}
-    
-class Approx
+class ResultBuilder : public ResultInfo
 {
 public:
     ///////////////////////////////////////////////////////////////////////////
-    // !TBD more generic
-    Approx
+    ResultBuilder
     (
-        double d
-    )
-    : m_d( d )
-    {
-    }
+        const char* expr,
+        bool isNot,
+        const char* filename,
+        std::size_t line,
+        const char* macroName
+    );
 
     ///////////////////////////////////////////////////////////////////////////
-    template<typename T>
-    friend bool operator == 
+    ~ResultBuilder
+    ();
+
+    ///////////////////////////////////////////////////////////////////////////
+    template<typename LhsT>
+    ChunkEvaluator<LhsT> operator <<
     (
-        const T& lhs, 
-        const Approx& rhs
+        const LhsT& lhs
     )
     {
-        // !TBD Use proper tolerance
-        // From: http://realtimecollisiondetection.net/blog/?p=89
-        // see also: http://www.cygnus-software.com/papers/comparingfloats/comparingfloats.htm
-        return fabs( lhs - rhs.m_d ) <= catch_max( CATCH_absTol, CATCH_relTol * catch_max( fabs(lhs), fabs(rhs.m_d) ) );
+        return ChunkEvaluator<LhsT>(*this, lhs, true, false);
     }
-    
+
     ///////////////////////////////////////////////////////////////////////////
-    template<typename T>
-    friend bool operator != 
-    (
-        const T& lhs, 
-        const Approx& rhs
-    )
+    void setIncomplete
+    ()
     {
-        return ! operator==( lhs, rhs );
+      m_incomplete = true;
     }
-    
-    double m_d;
-};
-
-///////////////////////////////////////////////////////////////////////////////
-template<>
-inline std::string toString<Approx>
-(
-    const Approx& value
-)
-{
-    std::ostringstream oss;
-    oss << "Approx( " << value.m_d << ")";
-    return oss.str();
-}
 
-///////////////////////////////////////////////////////////////////////////////
-// This is just here to avoid compiler warnings with macro constants
-inline bool isTrue
-(
-    bool value
-)
-{
-    return value;
-}
+    ///////////////////////////////////////////////////////////////////////////
+    void setResult
+    (
+        bool exprResult
+    );
 
-// Predeclarations for references in ChunkEvaluator and ReverseChunkEvaluator
-class ResultBuilder;
-class ReverseResultBuilder;
+    ///////////////////////////////////////////////////////////////////////////
+    void append
+    (
+        const std::string& exprChunk
+    );
 
-template<typename RhsT>
-class ReverseChunkEvaluator
-{
-public:
     ///////////////////////////////////////////////////////////////////////////
-    ReverseChunkEvaluator
+    void appendOperand
     (
-        const ReverseResultBuilder& parent,
-        const RhsT& operand,
-        bool result,
-        bool known = true
+        const void* operand,
+        Detail::OperandStringifier stringify
     );
 
     ///////////////////////////////////////////////////////////////////////////
-    const RhsT& getOperand
-    ()
-    const
-    {
-        return m_operand;
-    }
+    // Where the two halves of the expression meet: appends the operator and
+    // everything collected from the right, and sets the result
+    ResultBuilder& complete
+    (
+        const char* op,
+        const ReverseResultBuilder& rhs,
+        bool exprResult
+    );
+
+private:
+    std::string m_exprString;
+    bool m_incomplete;
+};
 
+// The parts of the chunk evaluators that don't depend on the operand type
+
+class ReverseChunkEvaluatorBase
+{
+public:
     ///////////////////////////////////////////////////////////////////////////
     ReverseResultBuilder& getParent
     ()
@@ -305,15 +815,84 @@ public:
         return m_known;
     }
 
+protected:
+    ///////////////////////////////////////////////////////////////////////////
+    ReverseChunkEvaluatorBase
+    (
+        const ReverseResultBuilder& parent,
+        const void* operand,
+        Detail::OperandStringifier stringify,
+        bool result,
+        bool known
+    )
+    :   m_parent(const_cast<ReverseResultBuilder&>(parent)), // Don't do this at home, kids
+        m_result(result),
+        m_known(known)
+    {
+        m_parent.prependOperand( operand, stringify );
+    }
+
 private:
-    const RhsT& m_operand;
     ReverseResultBuilder& m_parent;
     bool m_result;
     bool m_known;
 };
 
+class ChunkEvaluatorBase
+{
+protected:
+    ///////////////////////////////////////////////////////////////////////////
+    ChunkEvaluatorBase
+    (
+        ResultBuilder& parent,
+        const void* operand,
+        Detail::OperandStringifier stringify,
+        bool result,
+        bool known
+    )
+    :   m_parent(parent),
+        m_result(result),
+        m_known(known)
+    {
+        m_parent.appendOperand( operand, stringify );
+    }
+
+    ResultBuilder& m_parent;
+    bool m_result;
+    bool m_known;
+};
+
+template<typename RhsT>
+class ReverseChunkEvaluator : public ReverseChunkEvaluatorBase
+{
+public:
+    ///////////////////////////////////////////////////////////////////////////
+    ReverseChunkEvaluator
+    (
+        const ReverseResultBuilder& parent,
+        const RhsT& operand,
+        bool result,
+        bool known = true
+    )
+    :   ReverseChunkEvaluatorBase( parent, &operand, &Detail::stringifyOperand<RhsT>, result, known ),
+        m_operand(operand)
+    {
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    const RhsT& getOperand
+    ()
+    const
+    {
+        return m_operand;
+    }
+
+private:
+    const RhsT& m_operand;
+};
+
 template<typename LhsT>
-class ChunkEvaluator
+class ChunkEvaluator : public ChunkEvaluatorBase
 {
 public:
     ///////////////////////////////////////////////////////////////////////////
@@ -323,7 +902,11 @@ public:
         const LhsT& operand,
         bool result,
         bool known = true
-    );
+    )
+    :   ChunkEvaluatorBase( parent, &operand, &Detail::stringifyOperand<LhsT>, result, known ),
+        m_operand(operand)
+    {
+    }
 
     // Terminal cases
     ResultBuilder& operator << ( const ReverseResultBuilder& rhs );
@@ -377,137 +960,12 @@ public:
     template<typename RhsT>
     ChunkEvaluator<RhsT> operator >= ( const RhsT& rhs );
 
-    operator ResultBuilder&();
-
 private:
     const LhsT& m_operand;
-    ResultBuilder& m_parent;
-    bool m_result;
-    bool m_known;
-};
-
-class ReverseResultBuilder
-{
-public:
-    ///////////////////////////////////////////////////////////////////////////
-    void prepend
-    (
-        const std::string& exprChunk
-    )
-    {
-        m_exprString = exprChunk + m_exprString;
-    }
-
-    ///////////////////////////////////////////////////////////////////////////
-    const std::string& getExprString
-    ()
-    const
-    {
-        return m_exprString;
-    }
-
-private:
-    std::string m_exprString;
-};
-
-class ResultBuilder : public ResultInfo
-{
-public:
-    ///////////////////////////////////////////////////////////////////////////
-    ResultBuilder
-    (
-        const char* expr,
-        bool isNot,
-        const char* filename,
-        std::size_t line,
-        const char* macroName
-    )
-    : ResultInfo( expr, ResultWas::Unknown, isNot, filename, line, macroName ),
-      m_incomplete(false)
-    {}
-
-    ///////////////////////////////////////////////////////////////////////////
-    template<typename LhsT>
-    ChunkEvaluator<LhsT> operator <<
-    (
-        const LhsT& lhs
-    )
-    {
-        return ChunkEvaluator<LhsT>(*this, lhs, true, false);
-    }
-
-    ///////////////////////////////////////////////////////////////////////////
-    void setIncomplete
-    ()
-    {
-      m_incomplete = true;
-    }
-
-    ///////////////////////////////////////////////////////////////////////////
-    void setResult
-    (
-        bool exprResult
-    )
-    {
-        setResultData(exprResult);
-
-        if(!m_incomplete)
-          setExpressionString(m_exprString);
-        else
-          setExpressionString(m_exprString + " {can't expand the rest of the expression - consider rewriting it}");
-    }
-
-    ///////////////////////////////////////////////////////////////////////////
-    void append
-    (
-        const std::string& exprChunk
-    )
-    {
-        m_exprString += exprChunk;
-    }
-
-private:
-    std::string m_exprString;
-    bool m_incomplete;
 };
 
-// Chunk evaluator function definitions are outside the class since they make callbacks to the ResultBuilders
-
-///////////////////////////////////////////////////////////////////////////////
-template<typename LhsT>
-ChunkEvaluator<LhsT>::ChunkEvaluator
-(
-    ResultBuilder& parent,
-    const LhsT& operand,
-    bool result,
-    bool known
-)
-  : m_operand(operand),
-    m_parent(parent),
-    m_result(result),
-    m_known(known)
-{
-    m_parent.append( toString(operand) );
-}
-
-///////////////////////////////////////////////////////////////////////////////
-template<typename RhsT>
-ReverseChunkEvaluator<RhsT>::ReverseChunkEvaluator
-(
-    const ReverseResultBuilder& parent,
-    const RhsT& operand,
-    bool result,
-    bool known
-)
-  : m_operand(operand),
-    m_parent(const_cast<ReverseResultBuilder&>(parent)), // Don't do this at home, kids
-    m_result(result),
-    m_known(known)
-{
-    m_parent.prepend( toString(operand) );
-}
-
-// Terminal cases, where the chunk evaluators meet
+// Terminal cases, where the chunk evaluators meet. Only the comparison itself
+// is left to the template
 
 ///////////////////////////////////////////////////////////////////////////////
 template<typename LhsT>
@@ -517,9 +975,7 @@ ResultBuilder& ChunkEvaluator<LhsT>::operator <<
 )
 {
     if(!m_known) m_result = m_operand;
-    m_parent.append(rhs.getExprString());
-    m_parent.setResult(m_result);
-    return m_parent;
+    return m_parent.complete("", rhs, m_result);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -530,9 +986,7 @@ ResultBuilder& ChunkEvaluator<LhsT>::operator ==
     const ReverseChunkEvaluator<RhsT>& rhs
 )
 {
-    m_parent.append(" == " + rhs.getParent().getExprString());
-    m_parent.setResult((m_known || m_result) && m_operand == rhs.getOperand());
-    return m_parent;
+    return m_parent.complete(" == ", rhs.getParent(), (m_known || m_result) && m_operand == rhs.getOperand());
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -543,9 +997,7 @@ ResultBuilder& ChunkEvaluator<LhsT>::operator !=
     const ReverseChunkEvaluator<RhsT>& rhs
 )
 {
-    m_parent.append(" != " + rhs.getParent().getExprString());
-    m_parent.setResult((m_known || m_result) && m_operand != rhs.getOperand());
-    return m_parent;
+    return m_parent.complete(" != ", rhs.getParent(), (m_known || m_result) && m_operand != rhs.getOperand());
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -556,9 +1008,7 @@ ResultBuilder& ChunkEvaluator<LhsT>::operator <
     const ReverseChunkEvaluator<RhsT>& rhs
 )
 {
-    m_parent.append(" < " + rhs.getParent().getExprString());
-    m_parent.setResult((m_known || m_result) && m_operand < rhs.getOperand());
-    return m_parent;
+    return m_parent.complete(" < ", rhs.getParent(), (m_known || m_result) && m_operand < rhs.getOperand());
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -569,9 +1019,7 @@ ResultBuilder& ChunkEvaluator<LhsT>::operator >
     const ReverseChunkEvaluator<RhsT>& rhs
 )
 {
-    m_parent.append(" > " + rhs.getParent().getExprString());
-    m_parent.setResult((m_known || m_result) && m_operand > rhs.getOperand());
-    return m_parent;
+    return m_parent.complete(" > ", rhs.getParent(), (m_known || m_result) && m_operand > rhs.getOperand());
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -582,9 +1030,7 @@ ResultBuilder& ChunkEvaluator<LhsT>::operator <=
     const ReverseChunkEvaluator<RhsT>& rhs
 )
 {
-    m_parent.append(" <= " + rhs.getParent().getExprString());
-    m_parent.setResult((m_known || m_result) && m_operand <= rhs.getOperand());
-    return m_parent;
+    return m_parent.complete(" <= ", rhs.getParent(), (m_known || m_result) && m_operand <= rhs.getOperand());
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -595,9 +1041,7 @@ ResultBuilder& ChunkEvaluator<LhsT>::operator >=
     const ReverseChunkEvaluator<RhsT>& rhs
 )
 {
-    m_parent.append(" >= " + rhs.getParent().getExprString());
-    m_parent.setResult((m_known || m_result) && (m_operand >= rhs.getOperand()));
-    return m_parent;
+    return m_parent.complete(" >= ", rhs.getParent(), (m_known || m_result) && (m_operand >= rhs.getOperand()));
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -608,16 +1052,12 @@ ResultBuilder& ChunkEvaluator<LhsT>::operator ||
     const ReverseChunkEvaluator<RhsT>& rhs
 )
 {
-    m_parent.append(" || " + rhs.getParent().getExprString());
-
     if(!m_known) m_result = m_operand;
 
     if(rhs.isKnown())
-        m_parent.setResult(m_result || rhs.getResult());
+        return m_parent.complete(" || ", rhs.getParent(), m_result || rhs.getResult());
     else
-        m_parent.setResult(m_result || rhs.getOperand());
-
-    return m_parent;
+        return m_parent.complete(" || ", rhs.getParent(), m_result || rhs.getOperand());
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -628,16 +1068,12 @@ ResultBuilder& ChunkEvaluator<LhsT>::operator &&
     const ReverseChunkEvaluator<RhsT>& rhs
 )
 {
-    m_parent.append(" && " + rhs.getParent().getExprString());
-
     if(!m_known) m_result = m_operand;
 
     if(rhs.isKnown())
-        m_parent.setResult(m_result && rhs.getResult());
+        return m_parent.complete(" && ", rhs.getParent(), m_result && rhs.getResult());
     else
-        m_parent.setResult(m_result && rhs.getOperand());
-
-    return m_parent;
+        return m_parent.complete(" && ", rhs.getParent(), m_result && rhs.getOperand());
 }
 
 // Operators for consuming from the left (forward chunk evaluation)
@@ -835,7 +1271,7 @@ ReverseChunkEvaluator<LhsT> operator >=
     if( Catch::ResultAction::Value action = Catch::Hub::getResultCapture().acceptResult( result )  ) \
     { \
         if( action == Catch::ResultAction::DebugFailed ) DebugBreak(); \
-        if( Catch::isTrue( stopOnFailure ) ) throw Catch::TestFailureException(); \
+        if( Catch::isTrue( stopOnFailure ) && action != Catch::ResultAction::FailedOnWorkerThread ) throw Catch::TestFailureException(); \
     }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -869,7 +1305,7 @@ catch( ... ) \
 ///////////////////////////////////////////////////////////////////////////////
 #define INTERNAL_CATCH_MSG( reason, resultType, stopOnFailure, macroName ) \
     { \
-        std::ostringstream INTERNAL_CATCH_UNIQUE_NAME( strm ); \
+        Catch::MessageStream& INTERNAL_CATCH_UNIQUE_NAME( strm ) = Catch::Hub::getMessageStream(); \
         INTERNAL_CATCH_UNIQUE_NAME( strm ) << reason; \
         Catch::Hub::getResultCapture().acceptExpression( Catch::ResultInfo( "", Catch::ResultWas::Unknown, false, __FILE__, __LINE__, macroName ) ); \
         Catch::Hub::getResultCapture().acceptMessage( INTERNAL_CATCH_UNIQUE_NAME( strm ).str() ); \
@@ -877,6 +1313,6 @@ catch( ... ) \
     }
 
 ///////////////////////////////////////////////////////////////////////////////
-#define INTERNAL_CATCH_SCOPED_INFO( log ) Catch::ScopedInfo INTERNAL_CATCH_UNIQUE_NAME( info ); INTERNAL_CATCH_UNIQUE_NAME( info ) << log
+#define INTERNAL_CATCH_SCOPED_INFO( log ) Catch::ScopedInfo INTERNAL_CATCH_UNIQUE_NAME( info )( __FILE__, __LINE__ ); INTERNAL_CATCH_UNIQUE_NAME( info ) << log
 
 #endif // TWOBLUECUBES_CATCH_CAPTURE_HPP_INCLUDED
@@ -0,0 +1,687 @@
+/*
+ *  catch_capture_impl.hpp
+ *  Catch
+ *
+ *  Created by the Catch contributors on 19/10/2026.
+ *  Copyright 2026 the Catch contributors. All rights reserved.
+ *
+ *  Distributed under the Boost Software License, Version 1.0. (See accompanying
+ *  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ *
+ */
+#ifndef TWOBLUECUBES_CATCH_CAPTURE_IMPL_HPP_INCLUDED
+#define TWOBLUECUBES_CATCH_CAPTURE_IMPL_HPP_INCLUDED
+
+#include "catch_capture.hpp"
+#include "catch_hub.h"
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+
+namespace Catch
+{
+    namespace Detail
+    {
+        ///////////////////////////////////////////////////////////////////////////
+        std::string integerToString
+        (
+            unsigned long long magnitude,
+            bool negative
+        )
+        {
+            char buffer[24];
+            char* const end = buffer + sizeof( buffer );
+            char* start = end;
+            do
+            {
+                *--start = static_cast<char>( '0' + magnitude % 10 );
+                magnitude /= 10;
+            }
+            while( magnitude != 0 );
+            if( negative )
+                *--start = '-';
+            return std::string( start, end );
+        }
+
+        ///////////////////////////////////////////////////////////////////////////
+        // Works on the magnitude, as unsigned, so the most negative value of each
+        // type is fine too
+        template<typename T>
+        std::string signedToString
+        (
+            T value
+        )
+        {
+            return value < 0
+                ? integerToString( 0ULL - static_cast<unsigned long long>( value ), true )
+                : integerToString( static_cast<unsigned long long>( value ), false );
+        }
+
+        ///////////////////////////////////////////////////////////////////////////
+        std::string pointerToString
+        (
+            unsigned long long address
+        )
+        {
+            if( address == 0 )
+                return "NULL";
+
+            char buffer[20];
+            char* const end = buffer + sizeof( buffer );
+            char* start = end;
+            for( ; address != 0; address >>= 4 )
+                *--start = "0123456789abcdef"[address & 0xf];
+            *--start = 'x';
+            *--start = '0';
+            return std::string( start, end );
+        }
+
+        // How to write each floating point type, and read it back
+        template<typename T>
+        struct FloatingFormat;
+
+        template<>
+        struct FloatingFormat<float>
+        {
+            static const char* print() { return "%.*g"; }
+            static float read( const char* str ) { return static_cast<float>( std::strtod( str, NULL ) ); }
+        };
+
+        template<>
+        struct FloatingFormat<double>
+        {
+            static const char* print() { return "%.*g"; }
+            static double read( const char* str ) { return std::strtod( str, NULL ); }
+        };
+
+        template<>
+        struct FloatingFormat<long double>
+        {
+            // No strtold before C++11
+            static const char* print() { return "%.*Lg"; }
+            static long double read( const char* str )
+            {
+                long double value = 0;
+                std::sscanf( str, "%Lg", &value );
+                return value;
+            }
+        };
+
+        ///////////////////////////////////////////////////////////////////////////
+        // The shortest decimal that reads back as the same value. Anything that
+        // can be written in digits10 significant digits is written exactly that
+        // way by %g (which drops trailing zeros), so only the few lengths from
+        // there up to the most that could be needed have to be tried
+        template<typename T>
+        std::string floatingToString
+        (
+            T value
+        )
+        {
+            const int minDigits = std::numeric_limits<T>::digits10;
+            const int maxDigits = minDigits + 3;
+            // Non-finite values don't compare equal to themselves, after a round
+            // trip or otherwise
+            const bool finite = value == value && value - value == value - value;
+
+            char buffer[64];
+            for( int digits = minDigits; ; ++digits )
+            {
+                std::sprintf( buffer, FloatingFormat<T>::print(), digits, value );
+                if( !finite || digits == maxDigits || FloatingFormat<T>::read( buffer ) == value )
+                    return buffer;
+            }
+        }
+
+        ///////////////////////////////////////////////////////////////////////////
+        // Maps the bits of a float or double onto an unsigned scale on which
+        // adjacent representable values are adjacent integers (and +0 == -0)
+        template<typename FloatT, typename BitsT>
+        unsigned long long orderedBits
+        (
+            FloatT value
+        )
+        {
+            BitsT bits;
+            std::memcpy( &bits, &value, sizeof( bits ) );
+            const BitsT signBit = static_cast<BitsT>( 1 ) << ( sizeof( BitsT ) * 8 - 1 );
+            return ( bits & signBit )
+                ? static_cast<unsigned long long>( signBit ) - ( bits & ~signBit )
+                : static_cast<unsigned long long>( signBit ) + bits;
+        }
+
+        ///////////////////////////////////////////////////////////////////////////
+        template<typename FloatT, typename BitsT>
+        bool withinUlps
+        (
+            FloatT lhs,
+            FloatT rhs,
+            unsigned int ulps
+        )
+        {
+            if( lhs != lhs || rhs != rhs )
+                return false;
+            unsigned long long lhsBits = orderedBits<FloatT, BitsT>( lhs );
+            unsigned long long rhsBits = orderedBits<FloatT, BitsT>( rhs );
+            return ( lhsBits > rhsBits ? lhsBits - rhsBits : rhsBits - lhsBits ) <= ulps;
+        }
+
+        ///////////////////////////////////////////////////////////////////////////
+        // Counts the elements outside the (epsilon, margin) tolerance. Kept
+        // free of branches, so the compiler can vectorise it - the count is a
+        // double as (with plain SSE2, at least) a comparison of doubles
+        // can't feed an integer count in vector registers
+        template<typename T>
+        std::size_t countApproxMismatches
+        (
+            const T* values,
+            const double* expected,
+            std::size_t count,
+            double epsilon,
+            double margin
+        )
+        {
+            double mismatches = 0;
+            for( std::size_t i = 0; i < count; ++i )
+            {
+                const double value = values[i];
+                const double difference = std::fabs( value - expected[i] );
+                const double scale = catch_max( std::fabs( value ), std::fabs( expected[i] ) );
+                mismatches += difference <= catch_max( margin, epsilon * scale ) ? 0.0 : 1.0;
+            }
+            return static_cast<std::size_t>( mismatches );
+        }
+
+    }// end namespace Detail
+
+    ///////////////////////////////////////////////////////////////////////////
+    std::string toString
+    (
+        bool value
+    )
+    {
+        return value ? "true" : "false";
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    std::string toString
+    (
+        char value
+    )
+    {
+        return std::string( 1, value );
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    std::string toString
+    (
+        signed char value
+    )
+    {
+        return std::string( 1, static_cast<char>( value ) );
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    std::string toString
+    (
+        unsigned char value
+    )
+    {
+        return std::string( 1, static_cast<char>( value ) );
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    std::string toString
+    (
+        short value
+    )
+    {
+        return Detail::signedToString( value );
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    std::string toString
+    (
+        unsigned short value
+    )
+    {
+        return Detail::integerToString( value, false );
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    std::string toString
+    (
+        int value
+    )
+    {
+        return Detail::signedToString( value );
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    std::string toString
+    (
+        unsigned int value
+    )
+    {
+        return Detail::integerToString( value, false );
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    std::string toString
+    (
+        long value
+    )
+    {
+        return Detail::signedToString( value );
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    std::string toString
+    (
+        unsigned long value
+    )
+    {
+        return Detail::integerToString( value, false );
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    std::string toString
+    (
+        long long value
+    )
+    {
+        return Detail::signedToString( value );
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    std::string toString
+    (
+        unsigned long long value
+    )
+    {
+        return Detail::integerToString( value, false );
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    std::string toString
+    (
+        float value
+    )
+    {
+        return Detail::floatingToString( value );
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    std::string toString
+    (
+        double value
+    )
+    {
+        return Detail::floatingToString( value );
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    std::string toString
+    (
+        long double value
+    )
+    {
+        return Detail::floatingToString( value );
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    Approx::Approx
+    (
+        double value
+    )
+    :   m_value( value ),
+        m_isRange( false )
+    {
+        setDefaultTolerance();
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    Approx::Approx
+    (
+        const std::vector<double>& values
+    )
+    :   m_value( 0 ),
+        m_values( values ),
+        m_isRange( true )
+    {
+        setDefaultTolerance();
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    Approx::Approx
+    (
+        const std::vector<float>& values
+    )
+    :   m_value( 0 ),
+        m_values( values.begin(), values.end() ),
+        m_isRange( true )
+    {
+        setDefaultTolerance();
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    Approx::Approx
+    (
+        const double* values,
+        std::size_t count
+    )
+    :   m_value( 0 ),
+        m_values( values, values + count ),
+        m_isRange( true )
+    {
+        setDefaultTolerance();
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    Approx::Approx
+    (
+        const float* values,
+        std::size_t count
+    )
+    :   m_value( 0 ),
+        m_values( values, values + count ),
+        m_isRange( true )
+    {
+        setDefaultTolerance();
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    void Approx::setDefaultTolerance
+    ()
+    {
+        double fpTolerance = Hub::getFpTolerance();
+        m_epsilon = fpTolerance > 0 ? fpTolerance : 1e-10;
+        m_margin = 1e-10;
+        m_ulps = 0;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    bool Approx::withinTolerance
+    (
+        double value,
+        double expected,
+        bool isFloat
+    )
+    const
+    {
+        // From: http://realtimecollisiondetection.net/blog/?p=89
+        // see also: http://www.cygnus-software.com/papers/comparingfloats/comparingfloats.htm
+        if( std::fabs( value - expected ) <= catch_max( m_margin, m_epsilon * catch_max( std::fabs( value ), std::fabs( expected ) ) ) )
+            return true;
+        if( m_ulps == 0 )
+            return false;
+        return isFloat
+            ? Detail::withinUlps<float, unsigned int>( static_cast<float>( value ), static_cast<float>( expected ), m_ulps )
+            : Detail::withinUlps<double, unsigned long long>( value, expected, m_ulps );
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    bool Approx::matches
+    (
+        double value,
+        bool isFloat
+    )
+    const
+    {
+        return !m_isRange && withinTolerance( value, m_value, isFloat );
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // A single value is compared with every element
+    template<typename T>
+    bool Approx::matchesRange
+    (
+        const T* values,
+        std::size_t count
+    )
+    const
+    {
+        if( m_isRange && count != m_values.size() )
+            return false;
+        // Nothing to compare (and no elements to take the address of)
+        if( count == 0 )
+            return true;
+
+        std::vector<double> single;
+        if( !m_isRange )
+            single.assign( count, m_value );
+        const double* expected = m_isRange ? &m_values[0] : &single[0];
+        if( Detail::countApproxMismatches( values, expected, count, m_epsilon, m_margin ) == 0 )
+            return true;
+        if( m_ulps == 0 )
+            return false;
+
+        // Give the elements that were out a second chance, on ulps
+        for( std::size_t i = 0; i < count; ++i )
+            if( !withinTolerance( values[i], expected[i], Detail::IsFloat<T>::value ) )
+                return false;
+        return true;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    bool Approx::matches
+    (
+        const double* values,
+        std::size_t count
+    )
+    const
+    {
+        return matchesRange( values, count );
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    bool Approx::matches
+    (
+        const float* values,
+        std::size_t count
+    )
+    const
+    {
+        return matchesRange( values, count );
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    std::string Approx::describe
+    ()
+    const
+    {
+        return "Approx( " + ( m_isRange ? toString( m_values ) : toString( m_value ) ) + ")";
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    ///////////////////////////////////////////////////////////////////////////
+
+    ///////////////////////////////////////////////////////////////////////////
+    void ReverseResultBuilder::prepend
+    (
+        const std::string& exprChunk
+    )
+    {
+        m_exprString = exprChunk + m_exprString;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    void ReverseResultBuilder::prependOperand
+    (
+        const void* operand,
+        Detail::OperandStringifier stringify
+    )
+    {
+        m_exprString = stringify( operand ) + m_exprString;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    ///////////////////////////////////////////////////////////////////////////
+
+    ///////////////////////////////////////////////////////////////////////////
+    ResultBuilder::ResultBuilder
+    (
+        const char* expr,
+        bool isNot,
+        const char* filename,
+        std::size_t line,
+        const char* macroName
+    )
+    : ResultInfo( expr, ResultWas::Unknown, isNot, filename, line, macroName ),
+      m_incomplete(false)
+    {
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    ResultBuilder::~ResultBuilder
+    ()
+    {
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    void ResultBuilder::setResult
+    (
+        bool exprResult
+    )
+    {
+        setResultData(exprResult);
+
+        if(!m_incomplete)
+          setExpressionString(m_exprString);
+        else
+          setExpressionString(m_exprString + " {can't expand the rest of the expression - consider rewriting it}");
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    void ResultBuilder::append
+    (
+        const std::string& exprChunk
+    )
+    {
+        m_exprString += exprChunk;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    void ResultBuilder::appendOperand
+    (
+        const void* operand,
+        Detail::OperandStringifier stringify
+    )
+    {
+        m_exprString += stringify( operand );
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    ResultBuilder& ResultBuilder::complete
+    (
+        const char* op,
+        const ReverseResultBuilder& rhs,
+        bool exprResult
+    )
+    {
+        m_exprString += op;
+        m_exprString += rhs.getExprString();
+        setResult( exprResult );
+        return *this;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    int MessageStreamBuf::overflow
+    (
+        int c
+    )
+    {
+        if( c != EOF )
+            m_str += static_cast<char>( c );
+        return 0;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    std::streamsize MessageStreamBuf::xsputn
+    (
+        const char* s,
+        std::streamsize n
+    )
+    {
+        m_str.append( s, static_cast<std::size_t>( n ) );
+        return n;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    MessageStream::MessageStream
+    ()
+    :   std::ostream( 0 )
+    {
+        rdbuf( &m_buf );
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    void MessageStream::reset
+    ()
+    {
+        m_buf.clear();
+        clear();
+        flags( std::ios_base::dec | std::ios_base::skipws );
+        precision( 6 );
+        width( 0 );
+        fill( ' ' );
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    std::string ScopedInfo::getInfo
+    ()
+    const
+    {
+        std::string info;
+        for( std::size_t i = 0; i < m_partCount; ++i )
+        {
+            const Part& part = m_parts[i];
+            if( part.stringify )
+                info += part.stringify( &part.storage );
+            else
+                info.append( m_text, part.storage.textRange[0], part.storage.textRange[1] - part.storage.textRange[0] );
+        }
+        return info;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    ScopedInfo::Part& ScopedInfo::nextPart
+    ()
+    {
+        if( m_partCount == MaxParts )
+        {
+            // Out of room, so format what there is into a single part
+            std::string info = getInfo();
+            m_partCount = 0;
+            m_text.clear();
+            appendText( info );
+        }
+        return m_parts[m_partCount++];
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    void ScopedInfo::appendText
+    (
+        const std::string& text
+    )
+    {
+        // Consecutive text is kept as one part
+        if( m_partCount > 0 && !m_parts[m_partCount-1].stringify )
+        {
+            m_text += text;
+            m_parts[m_partCount-1].storage.textRange[1] = m_text.size();
+            return;
+        }
+        Part& part = nextPart();
+        part.stringify = 0;
+        part.storage.textRange[0] = m_text.size();
+        m_text += text;
+        part.storage.textRange[1] = m_text.size();
+    }
+
+} // end namespace Catch
+
+#endif // TWOBLUECUBES_CATCH_CAPTURE_IMPL_HPP_INCLUDED
@@ -15,6 +15,7 @@
 
 #include "catch_config.hpp"
 #include "catch_runner_impl.hpp"
+#include <cctype>
 
 namespace Catch
 {
@@ -22,14 +23,29 @@ namespace Catch
     //       have a table up front that relates the mode, option strings, # arguments, names of arguments
     //       - may not be worth it at this scale
     
-    // -l, --list tests [xml] lists available tests (optionally in xml)
-    // -l, --list reporters [xml] lists available reports (optionally in xml)
-    // -l, --list all [xml] lists available tests and reports (optionally in xml)
+    // -l, --list tests [xml|json] lists available tests (optionally in xml or json)
+    // -l, --list reporters [xml|json] lists available reports (optionally in xml or json)
+    // -l, --list all [xml|json] lists available tests and reports (optionally in xml or json)
     // -t, --test "testspec" ["testspec", ...]
-    // -r, --reporter <type>
-    // -o, --out filename to write to
+    // -r, --reporter <type> (may be repeated to report in several formats at once)
+    // -o, --out filename to write to (applies to the preceding reporter)
     // -s, --success report successful cases too
     // -b, --break breaks into debugger on test failure
+    // -a, --abort-after [N] stops starting test cases after N failures (default 1)
+    // --convert <file> replays a log written by the binary reporter
+    // --async [max queued events] reports from a background thread
+    // --timeout <seconds> fails and ends the run if a test case takes longer
+    // --state <file> records the outcome of each test case in file
+    // --rerun-failed runs only the test cases that failed, according to the state file
+    // --cache-dir <dir> skips test cases that passed before with the same build and options
+    // --cache-key <fingerprint> identifies the build, instead of hashing the executable
+    // --cache-refresh runs everything, updating the cache
+    // --order <decl|lex|rand> runs tests in declaration, lexical or random order
+    // --rng-seed <seed> seeds the random order, generators and properties, to reproduce a previous run
+    // --repeat <N> runs each test case N times, reporting how many of them failed
+    // --until-failure repeats each test case until it fails (at most N times with --repeat)
+    // --combine <all|pairwise> runs every combination of generated values, or every pair
+    // --generator-threads <N> shares the generated values of a test case between N threads
 	class ArgParser : NonCopyable
     {
         enum Mode
@@ -41,7 +57,23 @@ namespace Catch
             modeOutput,
             modeSuccess,
             modeBreak,
+            modeAbort,
             modeHelp,
+            modeConvert,
+            modeAsync,
+            modeTimeout,
+            modeState,
+            modeRerunFailed,
+            modeCacheDir,
+            modeCacheKey,
+            modeCacheRefresh,
+            modeOrder,
+            modeRngSeed,
+            modeRepeat,
+            modeUntilFailure,
+            modeCombine,
+            modeGeneratorThreads,
+            modeFpTolerance,
 
             modeError
         };
@@ -59,7 +91,9 @@ namespace Catch
         {
             for( int i=1; i < argc; ++i )
             {
-                if( argv[i][0] == '-' )
+                // A '-' followed by a digit is a (negative) number - let it
+                // through as an argument, to be rejected with a proper message
+                if( argv[i][0] == '-' && !std::isdigit( static_cast<unsigned char>( argv[i][1] ) ) )
                 {
                     std::string cmd = ( argv[i] );
                     if( cmd == "-l" || cmd == "--list" )
@@ -74,8 +108,40 @@ namespace Catch
                         changeMode( cmd, modeSuccess );
                     else if( cmd == "-b" || cmd == "--break" )
                         changeMode( cmd, modeBreak );
+                    else if( cmd == "-a" || cmd == "--abort-after" )
+                        changeMode( cmd, modeAbort );
                     else if( cmd == "-h" || cmd == "-?" || cmd == "--help" )
                         changeMode( cmd, modeHelp );
+                    else if( cmd == "--convert" )
+                        changeMode( cmd, modeConvert );
+                    else if( cmd == "--async" )
+                        changeMode( cmd, modeAsync );
+                    else if( cmd == "--timeout" )
+                        changeMode( cmd, modeTimeout );
+                    else if( cmd == "--state" )
+                        changeMode( cmd, modeState );
+                    else if( cmd == "--rerun-failed" )
+                        changeMode( cmd, modeRerunFailed );
+                    else if( cmd == "--cache-dir" )
+                        changeMode( cmd, modeCacheDir );
+                    else if( cmd == "--cache-key" )
+                        changeMode( cmd, modeCacheKey );
+                    else if( cmd == "--cache-refresh" )
+                        changeMode( cmd, modeCacheRefresh );
+                    else if( cmd == "--order" )
+                        changeMode( cmd, modeOrder );
+                    else if( cmd == "--rng-seed" )
+                        changeMode( cmd, modeRngSeed );
+                    else if( cmd == "--repeat" )
+                        changeMode( cmd, modeRepeat );
+                    else if( cmd == "--until-failure" )
+                        changeMode( cmd, modeUntilFailure );
+                    else if( cmd == "--combine" )
+                        changeMode( cmd, modeCombine );
+                    else if( cmd == "--generator-threads" )
+                        changeMode( cmd, modeGeneratorThreads );
+                    else if( cmd == "--fp-tolerance" )
+                        changeMode( cmd, modeFpTolerance );
                 }
                 else
                 {
@@ -132,17 +198,21 @@ namespace Catch
                                 listSpec = Config::List::Tests;
                             else if( m_args[0] == "reporters" )
                                 listSpec = Config::List::Reports;
+                            else if( m_args[0] == "all" )
+                                listSpec = Config::List::All;
                             else
-                                return setErrorMode( m_command + " expected [tests] or [reporters] but recieved: [" + m_args[0] + "]" );                        
+                                return setErrorMode( m_command + " expected [tests], [reporters] or [all] but recieved: [" + m_args[0] + "]" );                        
                         }
                         if( m_args.size() >= 2 )
                         {
                             if( m_args[1] == "xml" )
                                 listSpec = static_cast<Config::List::What>( listSpec | Config::List::AsXml );
+                            else if( m_args[1] == "json" )
+                                listSpec = static_cast<Config::List::What>( listSpec | Config::List::AsJson );
                             else if( m_args[1] == "text" )
                                 listSpec = static_cast<Config::List::What>( listSpec | Config::List::AsText );
                             else
-                                return setErrorMode( m_command + " expected [xml] or [text] but recieved: [" + m_args[1] + "]" );                        
+                                return setErrorMode( m_command + " expected [xml], [json] or [text] but recieved: [" + m_args[1] + "]" );                        
                         }
                         m_config.setListSpec( static_cast<Config::List::What>( m_config.getListSpec() | listSpec ) );
                     }
@@ -180,11 +250,139 @@ namespace Catch
                         return setErrorMode( m_command + " does not accept arguments" );
                     m_config.setShouldDebugBreak( true );
                     break;
+                case modeAbort:
+                    if( m_args.size() > 1 )
+                        return setErrorMode( m_command + " expected upto 1 argument but recieved: " + argsAsString() );
+                    {
+                        std::size_t failures = 1;
+                        if( m_args.size() == 1 && !parseCount( m_args[0], failures ) )
+                            return setErrorMode( m_command + " expected a positive number of failures but recieved: [" + m_args[0] + "]" );
+                        m_config.setAbortAfter( failures );
+                    }
+                    break;
                 case modeHelp:
                     if( m_args.size() != 0 )
                         return setErrorMode( m_command + " does not accept arguments" );
                     m_config.setShowHelp( true );
                     break;
+                case modeConvert:
+                    if( m_args.size() != 1 )
+                        return setErrorMode( m_command + " expected one argument, recieved: " +  argsAsString() );
+                    m_config.setConvertFilename( m_args[0] );
+                    break;
+                case modeAsync:
+                    if( m_args.size() > 1 )
+                        return setErrorMode( m_command + " expected upto 1 argument but recieved: " + argsAsString() );
+                    {
+                        std::size_t maxQueuedEvents = 1024;
+                        if( m_args.size() == 1 && !parseCount( m_args[0], maxQueuedEvents ) )
+                            return setErrorMode( m_command + " expected a positive number but recieved: [" + m_args[0] + "]" );
+                        m_config.setAsyncQueueSize( maxQueuedEvents );
+                    }
+                    break;
+                case modeTimeout:
+                    if( m_args.size() != 1 )
+                        return setErrorMode( m_command + " expected one argument, recieved: " +  argsAsString() );
+                    {
+                        std::size_t seconds = 0;
+                        if( !parseCount( m_args[0], seconds ) )
+                            return setErrorMode( m_command + " expected a positive number of seconds but recieved: [" + m_args[0] + "]" );
+                        m_config.setTimeout( static_cast<unsigned int>( seconds ) );
+                    }
+                    break;
+                case modeState:
+                    if( m_args.size() != 1 )
+                        return setErrorMode( m_command + " expected one argument, recieved: " +  argsAsString() );
+                    m_config.setStateFilename( m_args[0] );
+                    break;
+                case modeRerunFailed:
+                    if( m_args.size() != 0 )
+                        return setErrorMode( m_command + " does not accept arguments" );
+                    m_config.setRerunFailed( true );
+                    break;
+                case modeCacheDir:
+                    if( m_args.size() != 1 )
+                        return setErrorMode( m_command + " expected one argument, recieved: " +  argsAsString() );
+                    m_config.setCacheDir( m_args[0] );
+                    break;
+                case modeCacheKey:
+                    if( m_args.size() != 1 )
+                        return setErrorMode( m_command + " expected one argument, recieved: " +  argsAsString() );
+                    m_config.setBuildFingerprint( m_args[0] );
+                    break;
+                case modeCacheRefresh:
+                    if( m_args.size() != 0 )
+                        return setErrorMode( m_command + " does not accept arguments" );
+                    m_config.setRefreshCache( true );
+                    break;
+                case modeOrder:
+                    if( m_args.size() != 1 )
+                        return setErrorMode( m_command + " expected one argument, recieved: " +  argsAsString() );
+                    if( m_args[0] == "decl" )
+                        m_config.setOrder( Config::Order::Declared );
+                    else if( m_args[0] == "lex" )
+                        m_config.setOrder( Config::Order::Lexical );
+                    else if( m_args[0] == "rand" )
+                        m_config.setOrder( Config::Order::Random );
+                    else
+                        return setErrorMode( m_command + " expected [decl], [lex] or [rand] but recieved: [" + m_args[0] + "]" );
+                    break;
+                case modeRngSeed:
+                    if( m_args.size() != 1 )
+                        return setErrorMode( m_command + " expected one argument, recieved: " +  argsAsString() );
+                    {
+                        std::size_t seed = 0;
+                        if( !parseNumber( m_args[0], seed ) || seed > 0xffffffffUL )
+                            return setErrorMode( m_command + " expected a 32 bit number but recieved: [" + m_args[0] + "]" );
+                        m_config.setRngSeed( static_cast<unsigned int>( seed ) );
+                    }
+                    break;
+                case modeRepeat:
+                    if( m_args.size() != 1 )
+                        return setErrorMode( m_command + " expected one argument, recieved: " +  argsAsString() );
+                    {
+                        std::size_t repeatCount = 0;
+                        if( !parseCount( m_args[0], repeatCount ) )
+                            return setErrorMode( m_command + " expected a positive number but recieved: [" + m_args[0] + "]" );
+                        m_config.setRepeatCount( repeatCount );
+                    }
+                    break;
+                case modeUntilFailure:
+                    if( m_args.size() != 0 )
+                        return setErrorMode( m_command + " does not accept arguments" );
+                    m_config.setRepeatUntilFailure( true );
+                    break;
+                case modeCombine:
+                    if( m_args.size() != 1 )
+                        return setErrorMode( m_command + " expected one argument, recieved: " +  argsAsString() );
+                    if( m_args[0] == "all" )
+                        m_config.setCombination( Combination::AllCombinations );
+                    else if( m_args[0] == "pairwise" )
+                        m_config.setCombination( Combination::Pairwise );
+                    else
+                        return setErrorMode( m_command + " expected [all] or [pairwise] but recieved: [" + m_args[0] + "]" );
+                    break;
+                case modeGeneratorThreads:
+                    if( m_args.size() != 1 )
+                        return setErrorMode( m_command + " expected one argument, recieved: " +  argsAsString() );
+                    {
+                        std::size_t threads = 0;
+                        if( !parseCount( m_args[0], threads ) )
+                            return setErrorMode( m_command + " expected a positive number but recieved: [" + m_args[0] + "]" );
+                        m_config.setGeneratorThreads( threads );
+                    }
+                    break;
+                case modeFpTolerance:
+                    if( m_args.size() != 1 )
+                        return setErrorMode( m_command + " expected one argument, recieved: " +  argsAsString() );
+                    {
+                        std::istringstream iss( m_args[0] );
+                        double epsilon = 0;
+                        if( !( iss >> epsilon ) || !iss.eof() || !( epsilon > 0 ) )
+                            return setErrorMode( m_command + " expected a positive number but recieved: [" + m_args[0] + "]" );
+                        m_config.setFpTolerance( epsilon );
+                    }
+                    break;
                 default:
                 break;
             }
@@ -192,6 +390,32 @@ namespace Catch
             m_mode = mode;
         }
         
+        ///////////////////////////////////////////////////////////////////////
+        static bool parseNumber
+        (
+            const std::string& arg,
+            std::size_t& number
+        )
+        {
+            // Extracting a size_t accepts a sign (and wraps "-1" round to a
+            // huge count) and skips leading whitespace, so only digits are let
+            // through to it
+            if( arg.empty() || arg.find_first_not_of( "0123456789" ) != std::string::npos )
+                return false;
+            std::istringstream iss( arg );
+            return ( iss >> number ) && iss.eof();
+        }
+        
+        ///////////////////////////////////////////////////////////////////////
+        static bool parseCount
+        (
+            const std::string& arg,
+            std::size_t& count
+        )
+        {
+            return parseNumber( arg, count ) && count > 0;
+        }
+        
         ///////////////////////////////////////////////////////////////////////
         void setErrorMode
         (
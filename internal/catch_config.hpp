@@ -14,11 +14,14 @@
 #define TWOBLUECUBES_CATCH_RUNNERCONFIG_HPP_INCLUDED
 
 #include "catch_interfaces_reporter.h"
+#include "catch_reporter_multi.hpp"
 #include "catch_hub.h"
+#include "catch_generators_impl.hpp"
 
 #include <memory>
 #include <vector>
 #include <string>
+#include <sstream>
 #include <iostream>
 
 namespace Catch
@@ -37,6 +40,13 @@ namespace Catch
             SuccessfulResults
         }; };
 
+        struct Order { enum What
+        {
+            Declared,
+            Lexical,
+            Random
+        }; };
+
         struct List{ enum What
         {
             None = 0,
@@ -48,7 +58,8 @@ namespace Catch
             WhatMask = 0xf,
             
             AsText = 0x10,
-            AsXml = 0x11,
+            AsXml = 0x20,
+            AsJson = 0x30,
             
             AsMask = 0xf0
         }; };
@@ -57,9 +68,23 @@ namespace Catch
         ///////////////////////////////////////////////////////////////////////////
         Config()
         :   m_reporter( NULL ),
+            m_multiReporter( NULL ),
             m_listSpec( List::None ),
             m_shouldDebugBreak( false ),
             m_showHelp( false ),
+            m_asyncQueueSize( 0 ),
+            m_timeout( 0 ),
+            m_abortAfter( 0 ),
+            m_rerunFailed( false ),
+            m_refreshCache( false ),
+            m_order( Order::Declared ),
+            m_rngSeed( 0 ),
+            m_rngSeedGiven( false ),
+            m_repeatCount( 0 ),
+            m_repeatUntilFailure( false ),
+            m_combination( Combination::AllCombinations ),
+            m_generatorThreads( 0 ),
+            m_fpTolerance( 0 ),
             m_streambuf( std::cout.rdbuf() ),
             m_os( m_streambuf ),
             m_includeWhat( Include::FailedOnly )
@@ -74,9 +99,29 @@ namespace Catch
         ///////////////////////////////////////////////////////////////////////////
         void setReporter( const std::string& reporterName )
         {
-            if( m_reporter.get() )
-                return setError( "Only one reporter may be specified" );
-            setReporter( Hub::getReporterRegistry().create( reporterName, *this ) );
+            if( !m_reporter.get() )
+            {
+                IReporter* reporter = Hub::getReporterRegistry().create( reporterName, *this );
+                if( !reporter )
+                    return setError( "Unknown reporter: " + reporterName );
+                m_reporterName = reporterName;
+                return setReporter( reporter );
+            }
+
+            // Subsequent reporters each get their own output and are driven
+            // alongside the first through a MultiReporter
+            std::auto_ptr<ReporterOutput> output( new ReporterOutput( *this, writesBinary( reporterName ) ) );
+            IReporter* reporter = Hub::getReporterRegistry().create( reporterName, *output );
+            if( !reporter )
+                return setError( "Unknown reporter: " + reporterName );
+            if( !m_multiReporter )
+            {
+                std::auto_ptr<MultiReporter> multiReporter( new MultiReporter() );
+                multiReporter->add( m_reporter.release() );
+                m_multiReporter = multiReporter.get();
+                m_reporter = std::auto_ptr<IReporter>( multiReporter.release() );
+            }
+            m_multiReporter->add( reporter, output.release() );
         }
         
         ///////////////////////////////////////////////////////////////////////////
@@ -110,9 +155,18 @@ namespace Catch
         }
         
         ///////////////////////////////////////////////////////////////////////////
+        // Output options apply to the most recently specified reporter
         void setFilename( const std::string& filename )
         {
-            m_filename = filename;
+            if( ReporterOutput* output = getLastReporterOutput() )
+            {
+                if( !output->setFilename( filename ) )
+                    setError( "Unable to open file: '" + filename + "'" );
+            }
+            else
+            {
+                m_filename = filename;
+            }
         }
         
         ///////////////////////////////////////////////////////////////////////////
@@ -121,6 +175,241 @@ namespace Catch
             return m_filename;
         }
         
+        ///////////////////////////////////////////////////////////////////////////
+        // Whether the file from getFilename() is to be opened in binary mode,
+        // as it is for the first reporter
+        bool isBinaryOutput() const
+        {
+            return writesBinary( m_reporterName );
+        }
+        
+        ///////////////////////////////////////////////////////////////////////////
+        // The binary reporter's output must not have its line endings translated
+        static bool writesBinary( const std::string& reporterName )
+        {
+            return reporterName == "binary";
+        }
+        
+        ///////////////////////////////////////////////////////////////////////////
+        void setConvertFilename( const std::string& filename )
+        {
+            m_convertFilename = filename;
+        }
+        
+        ///////////////////////////////////////////////////////////////////////////
+        const std::string& getConvertFilename() const
+        {
+            return m_convertFilename;
+        }
+        
+        ///////////////////////////////////////////////////////////////////////////
+        // File the outcome of each test case is recorded in, for the next run
+        void setStateFilename( const std::string& filename )
+        {
+            m_stateFilename = filename;
+        }
+        
+        ///////////////////////////////////////////////////////////////////////////
+        const std::string& getStateFilename() const
+        {
+            return m_stateFilename;
+        }
+        
+        ///////////////////////////////////////////////////////////////////////////
+        void setRerunFailed( bool rerunFailed )
+        {
+            m_rerunFailed = rerunFailed;
+        }
+        
+        ///////////////////////////////////////////////////////////////////////////
+        bool shouldRerunFailed() const
+        {
+            return m_rerunFailed;
+        }
+        
+        ///////////////////////////////////////////////////////////////////////////
+        // Directory in which passing results are cached between runs
+        void setCacheDir( const std::string& directory )
+        {
+            m_cacheDir = directory;
+        }
+        
+        ///////////////////////////////////////////////////////////////////////////
+        const std::string& getCacheDir() const
+        {
+            return m_cacheDir;
+        }
+        
+        ///////////////////////////////////////////////////////////////////////////
+        // Run everything, ignoring (but updating) the cache
+        void setRefreshCache( bool refreshCache )
+        {
+            m_refreshCache = refreshCache;
+        }
+        
+        ///////////////////////////////////////////////////////////////////////////
+        bool shouldRefreshCache() const
+        {
+            return m_refreshCache;
+        }
+        
+        ///////////////////////////////////////////////////////////////////////////
+        // Identifies the build of the tests, for the result cache
+        void setBuildFingerprint( const std::string& fingerprint )
+        {
+            m_buildFingerprint = fingerprint;
+        }
+        
+        ///////////////////////////////////////////////////////////////////////////
+        const std::string& getBuildFingerprint() const
+        {
+            return m_buildFingerprint;
+        }
+        
+        ///////////////////////////////////////////////////////////////////////////
+        // The options that can change whether a test passes, so cached results
+        // are only reused when they are the same. A seed picked afresh for the
+        // run is left out - it would never match the next run's, so nothing
+        // would ever be reused. Instead the results of tests that used it (a
+        // random generator or a property) aren't cached at all. A seed given
+        // with --rng-seed is part of the key
+        std::string getOutcomeOptions() const
+        {
+            std::ostringstream oss;
+            oss << "timeout=" << m_timeout << " combine=" << m_combination << " fp-tolerance=" << m_fpTolerance;
+            if( m_rngSeedGiven )
+                oss << " rng-seed=" << m_rngSeed;
+            return oss.str();
+        }
+        
+        ///////////////////////////////////////////////////////////////////////////
+        void setOrder( Order::What order )
+        {
+            m_order = order;
+        }
+        
+        ///////////////////////////////////////////////////////////////////////////
+        Order::What getOrder() const
+        {
+            return m_order;
+        }
+        
+        ///////////////////////////////////////////////////////////////////////////
+        // A seed given to reproduce an earlier run. Any value, zero included
+        void setRngSeed( unsigned int seed )
+        {
+            m_rngSeed = seed;
+            m_rngSeedGiven = true;
+        }
+        
+        ///////////////////////////////////////////////////////////////////////////
+        // A seed picked afresh for this run
+        void chooseRngSeed( unsigned int seed )
+        {
+            m_rngSeed = seed;
+            m_rngSeedGiven = false;
+        }
+        
+        ///////////////////////////////////////////////////////////////////////////
+        bool isRngSeedGiven() const
+        {
+            return m_rngSeedGiven;
+        }
+        
+        ///////////////////////////////////////////////////////////////////////////
+        unsigned int getRngSeed() const
+        {
+            return m_rngSeed;
+        }
+        
+        ///////////////////////////////////////////////////////////////////////////
+        // The seed shapes the whole run when it orders the tests, or when it
+        // was given to reproduce an earlier run. Otherwise it only matters
+        // to the tests that draw random numbers, and is reported with them
+        bool isRngSeedReported() const
+        {
+            return m_rngSeedGiven || m_order == Order::Random;
+        }
+        
+        ///////////////////////////////////////////////////////////////////////////
+        virtual unsigned int rngSeed() const
+        {
+            return isRngSeedReported() ? m_rngSeed : 0;
+        }
+        
+        ///////////////////////////////////////////////////////////////////////////
+        // How many times to run each test case. Zero if not specified: once,
+        // or without limit when repeating until failure
+        void setRepeatCount( std::size_t repeatCount )
+        {
+            m_repeatCount = repeatCount;
+        }
+        
+        ///////////////////////////////////////////////////////////////////////////
+        std::size_t getRepeatCount() const
+        {
+            return m_repeatCount;
+        }
+        
+        ///////////////////////////////////////////////////////////////////////////
+        void setRepeatUntilFailure( bool repeatUntilFailure )
+        {
+            m_repeatUntilFailure = repeatUntilFailure;
+        }
+        
+        ///////////////////////////////////////////////////////////////////////////
+        bool shouldRepeatUntilFailure() const
+        {
+            return m_repeatUntilFailure;
+        }
+        
+        ///////////////////////////////////////////////////////////////////////////
+        // Whether each test case is run more than once
+        bool shouldRepeat() const
+        {
+            return m_repeatCount > 1 || m_repeatUntilFailure;
+        }
+        
+        ///////////////////////////////////////////////////////////////////////////
+        void setCombination( Combination::What combination )
+        {
+            m_combination = combination;
+        }
+        
+        ///////////////////////////////////////////////////////////////////////////
+        Combination::What getCombination() const
+        {
+            return m_combination;
+        }
+        
+        ///////////////////////////////////////////////////////////////////////////
+        // How many threads to share the generated values of a test case
+        // between. Zero (or one) runs them all on the test's own thread
+        void setGeneratorThreads( std::size_t generatorThreads )
+        {
+            m_generatorThreads = generatorThreads;
+        }
+        
+        ///////////////////////////////////////////////////////////////////////////
+        std::size_t getGeneratorThreads() const
+        {
+            return m_generatorThreads;
+        }
+        
+        ///////////////////////////////////////////////////////////////////////////
+        // The relative tolerance Approx uses unless told otherwise. Zero for
+        // its own default
+        void setFpTolerance( double epsilon )
+        {
+            m_fpTolerance = epsilon;
+        }
+        
+        ///////////////////////////////////////////////////////////////////////////
+        double getFpTolerance() const
+        {
+            return m_fpTolerance;
+        }
+        
         ///////////////////////////////////////////////////////////////////////////
         const std::string& getMessage() const
         {
@@ -137,6 +426,7 @@ namespace Catch
         void setReporter( IReporter* reporter )
         {
             m_reporter = std::auto_ptr<IReporter>( reporter );
+            m_multiReporter = NULL;
         }
         
         ///////////////////////////////////////////////////////////////////////////
@@ -177,6 +467,56 @@ namespace Catch
             return m_shouldDebugBreak;
         }
 
+        ///////////////////////////////////////////////////////////////////////////
+        // A queue size of zero means results are reported synchronously
+        void setAsyncQueueSize( std::size_t maxQueuedEvents )
+        {
+            m_asyncQueueSize = maxQueuedEvents;
+        }
+
+        ///////////////////////////////////////////////////////////////////////////
+        std::size_t getAsyncQueueSize() const
+        {
+            return m_asyncQueueSize;
+        }
+
+        ///////////////////////////////////////////////////////////////////////////
+        // Default timeout for each test case, in seconds. Zero for no timeout
+        void setTimeout( unsigned int seconds )
+        {
+            m_timeout = seconds;
+        }
+
+        ///////////////////////////////////////////////////////////////////////////
+        unsigned int getTimeout() const
+        {
+            return m_timeout;
+        }
+
+        ///////////////////////////////////////////////////////////////////////////
+        // Number of failures after which no more test cases are started.
+        // Zero to always run everything
+        void setAbortAfter( std::size_t failures )
+        {
+            m_abortAfter = failures;
+        }
+
+        ///////////////////////////////////////////////////////////////////////////
+        std::size_t getAbortAfter() const
+        {
+            return m_abortAfter;
+        }
+
+        ///////////////////////////////////////////////////////////////////////////
+        // Hands the current reporter over to the caller, to be wrapped in some
+        // other reporter that is then passed back in through setReporter()
+        IReporter* releaseReporter()
+        {
+            getReporter();
+            m_multiReporter = NULL;
+            return m_reporter.release();
+        }
+
         ///////////////////////////////////////////////////////////////////////////
         void setShowHelp( bool showHelpFlag )
         {
@@ -195,6 +535,15 @@ namespace Catch
             return m_os;
         }
         
+        ///////////////////////////////////////////////////////////////////////////
+        // Pushes anything the reporters have written so far out of our buffers
+        void flush() const
+        {
+            m_os.flush();
+            if( m_multiReporter )
+                m_multiReporter->flushOutputs();
+        }
+
         ///////////////////////////////////////////////////////////////////////////
         void setStreamBuf( std::streambuf* buf )
         {
@@ -209,7 +558,10 @@ namespace Catch
         ///////////////////////////////////////////////////////////////////////////
         void useStream( const std::string& streamName )
         {
-            setStreamBuf( Hub::createStreamBuf( streamName ) );
+            if( ReporterOutput* output = getLastReporterOutput() )
+                output->useStream( streamName );
+            else
+                setStreamBuf( Hub::createStreamBuf( streamName ) );
         }        
         
         ///////////////////////////////////////////////////////////////////////////
@@ -219,13 +571,38 @@ namespace Catch
         }
         
     private:
+        ///////////////////////////////////////////////////////////////////////////
+        ReporterOutput* getLastReporterOutput()
+        {
+            return m_multiReporter ? m_multiReporter->getLastOutput() : NULL;
+        }
+        
         std::auto_ptr<IReporter> m_reporter;
+        MultiReporter* m_multiReporter;
         std::string m_filename;
+        std::string m_reporterName;
+        std::string m_convertFilename;
         std::string m_message;
         List::What m_listSpec;
         std::vector<std::string> m_testSpecs;
         bool m_shouldDebugBreak;
         bool m_showHelp;
+        std::size_t m_asyncQueueSize;
+        unsigned int m_timeout;
+        std::size_t m_abortAfter;
+        std::string m_stateFilename;
+        bool m_rerunFailed;
+        std::string m_cacheDir;
+        bool m_refreshCache;
+        std::string m_buildFingerprint;
+        Order::What m_order;
+        unsigned int m_rngSeed;
+        bool m_rngSeedGiven;
+        std::size_t m_repeatCount;
+        bool m_repeatUntilFailure;
+        Combination::What m_combination;
+        std::size_t m_generatorThreads;
+        double m_fpTolerance;
         std::streambuf* m_streambuf;
         mutable std::ostream m_os;
         Include::What m_includeWhat;        
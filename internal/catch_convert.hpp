@@ -0,0 +1,51 @@
+/*
+ *  catch_convert.hpp
+ *  Catch
+ *
+ *  Created by the Catch contributors on 19/10/2026.
+ *  Copyright 2026 the Catch contributors. All rights reserved.
+ *
+ *  Distributed under the Boost Software License, Version 1.0. (See accompanying
+ *  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ *
+ */
+
+#ifndef TWOBLUECUBES_CATCH_CONVERT_HPP_INCLUDED
+#define TWOBLUECUBES_CATCH_CONVERT_HPP_INCLUDED
+
+#include "catch_commandline.hpp"
+#include "catch_binary_log.hpp"
+
+#include <fstream>
+#include <limits>
+
+namespace Catch
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // Replays a log written by the binary reporter into the configured reporter.
+    // Returns the number of failures in the logged run, as that run did
+    inline int Convert
+    (
+        Config& config
+    )
+    {
+        std::ifstream ifs( config.getConvertFilename().c_str(), std::ios::in | std::ios::binary );
+        if( ifs.fail() )
+        {
+            std::cerr << "Unable to open file: '" << config.getConvertFilename() << "'" << std::endl;
+            return std::numeric_limits<int>::max();
+        }
+
+        BinaryLogReader reader( ifs );
+        std::string error = reader.replay( config );
+        if( !error.empty() )
+        {
+            std::cerr << error << ": '" << config.getConvertFilename() << "'" << std::endl;
+            return std::numeric_limits<int>::max();
+        }
+        return static_cast<int>( reader.getFailureCount() );
+    }
+
+} // end namespace Catch
+
+#endif // TWOBLUECUBES_CATCH_CONVERT_HPP_INCLUDED
@@ -15,8 +15,6 @@
 #ifndef TWOBLUECUBES_CATCH_DEBUGGER_HPP_INCLUDED
 #define TWOBLUECUBES_CATCH_DEBUGGER_HPP_INCLUDED
 
-#include <iostream>
-
 #if defined(macintosh) || defined(__APPLE__) || defined(__APPLE_CC__)
 
     #include <assert.h>
@@ -85,16 +83,4 @@
     inline void DebugBreak(){}
 #endif
 
-inline void writeToDebugConsole( const std::string& text )
-{
-    // !TBD: Get Windows version working
-    // - need to declare OutputDebugStringA without Windows.h
-//#ifdef _WIN32
-//    ::OutputDebugStringA( text.c_str() );    
-//#else
-    // !TBD: Need a version for Mac/ XCode and other IDEs
-    std::cout << text;
-//#endif
-}
-
 #endif // TWOBLUECUBES_CATCH_DEBUGGER_HPP_INCLUDED
\ No newline at end of file
@@ -0,0 +1,178 @@
+/*
+ *  catch_fatal_signals.hpp
+ *  Catch
+ *
+ *  Created by the Catch contributors on 19/10/2026.
+ *  Copyright 2026 the Catch contributors. All rights reserved.
+ *
+ *  Distributed under the Boost Software License, Version 1.0. (See accompanying
+ *  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ *
+ */
+#ifndef TWOBLUECUBES_CATCH_FATAL_SIGNALS_HPP_INCLUDED
+#define TWOBLUECUBES_CATCH_FATAL_SIGNALS_HPP_INCLUDED
+
+#include "catch_common.h"
+#include "catch_thread.hpp"
+
+#include <string>
+#include <cstring>
+
+#ifndef _WIN32
+    #include <signal.h>
+    #include <unistd.h>
+#endif
+
+namespace Catch
+{
+    struct IFatalSignalHandler
+    {
+        virtual ~IFatalSignalHandler
+        ()
+        {}
+
+        // Called from within the signal handler, on the thread that installed
+        // the handler. Reporting from there can only be best effort - the
+        // process is in an unknown state - and it is terminated with the
+        // original signal once this returns
+        virtual void fatalSignal
+            (   const std::string& signalName
+            ) = 0;
+    };
+
+#ifndef _WIN32
+
+    // Installs handlers for the signals that would otherwise kill the process
+    // without a trace, for as long as it is in scope. The IFatalSignalHandler
+    // is the calling thread's - guards may be nested (e.g. by a Runner within
+    // a test), and each puts the previous handler back. A fault on a thread
+    // without one (one the test started, or the async reporter's) is only
+    // written to stderr, which is all that can safely be done in a signal
+    // handler, as the thread that could report it is still running
+    class FatalSignalGuard : NonCopyable
+    {
+        enum { SignalCount = 4 };
+        enum { AltStackSize = 32768 };
+
+        struct SignalDef
+        {
+            int m_id;
+            const char* m_name;
+        };
+
+        static const SignalDef* signalDefs
+        ()
+        {
+            static const SignalDef defs[SignalCount] =
+            {
+                { SIGSEGV, "SIGSEGV - Segmentation violation" },
+                { SIGFPE,  "SIGFPE - Floating point error" },
+                { SIGABRT, "SIGABRT - Abort (abnormal termination)" },
+                { SIGBUS,  "SIGBUS - Bus error" }
+            };
+            return defs;
+        }
+
+    public:
+        ///////////////////////////////////////////////////////////////////////
+        explicit FatalSignalGuard
+        (
+            IFatalSignalHandler& handler
+        )
+        :   m_prevHandler( currentHandler() )
+        {
+            currentHandler() = &handler;
+
+            // A stack overflow leaves no stack to handle the SIGSEGV on
+            static char altStackMem[AltStackSize];
+            stack_t altStack;
+            altStack.ss_sp = altStackMem;
+            altStack.ss_size = sizeof( altStackMem );
+            altStack.ss_flags = 0;
+            sigaltstack( &altStack, &m_prevAltStack );
+
+            struct sigaction action;
+            action.sa_handler = &FatalSignalGuard::handleSignal;
+            sigemptyset( &action.sa_mask );
+            action.sa_flags = SA_ONSTACK;
+            for( int i = 0; i < SignalCount; ++i )
+                sigaction( signalDefs()[i].m_id, &action, &m_prevActions[i] );
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        ~FatalSignalGuard
+        ()
+        {
+            for( int i = 0; i < SignalCount; ++i )
+                sigaction( signalDefs()[i].m_id, &m_prevActions[i], NULL );
+            sigaltstack( &m_prevAltStack, NULL );
+            currentHandler() = m_prevHandler;
+        }
+
+    private:
+        ///////////////////////////////////////////////////////////////////////
+        static ThreadLocal<IFatalSignalHandler*>& handlers
+        ()
+        {
+            static ThreadLocal<IFatalSignalHandler*> handlers;
+            return handlers;
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        static IFatalSignalHandler*& currentHandler
+        ()
+        {
+            return handlers().get();
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        static void handleSignal
+        (
+            int sig
+        )
+        {
+            // Put the default action back first, so a second fault while
+            // reporting this one terminates rather than recursing
+            signal( sig, SIG_DFL );
+
+            const char* name = "Unknown signal";
+            for( int i = 0; i < SignalCount; ++i )
+                if( signalDefs()[i].m_id == sig )
+                    name = signalDefs()[i].m_name;
+
+            // find() doesn't allocate, unlike get()
+            IFatalSignalHandler** handler = handlers().find();
+            if( handler && *handler )
+            {
+                (*handler)->fatalSignal( name );
+            }
+            else
+            {
+                const char prefix[] = "\nFatal error on a thread of the test: ";
+                ssize_t written = write( STDERR_FILENO, prefix, sizeof( prefix ) - 1 );
+                written = write( STDERR_FILENO, name, std::strlen( name ) );
+                written = write( STDERR_FILENO, "\n", 1 );
+                (void)written;
+            }
+            raise( sig );
+        }
+
+        IFatalSignalHandler* m_prevHandler;
+        struct sigaction m_prevActions[SignalCount];
+        stack_t m_prevAltStack;
+    };
+
+#else
+
+    // Structured exceptions are not handled on Windows yet
+    class FatalSignalGuard : NonCopyable
+    {
+    public:
+        explicit FatalSignalGuard( IFatalSignalHandler& ){}
+    };
+
+#endif
+
+} // end namespace Catch
+
+#endif // TWOBLUECUBES_CATCH_FATAL_SIGNALS_HPP_INCLUDED
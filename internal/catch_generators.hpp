@@ -14,10 +14,13 @@
 #define TWOBLUECUBES_CATCH_GENERATORS_HPP_INCLUDED
 
 #include "catch_hub.h"
+#include "catch_common.h"
+#include "catch_random.hpp"
 
-#include <iterator>
 #include <vector>
 #include <string>
+#include <limits>
+#include <stdexcept>
 #include <stdlib.h>
 
 namespace Catch
@@ -34,10 +37,28 @@ struct IGenerator
         ( std::size_t index
         ) const = 0;
     
+    // infiniteSize() for a generator that never runs out
     virtual std::size_t size
         () const = 0;
 };
 
+///////////////////////////////////////////////////////////////////////////////
+inline std::size_t infiniteSize
+()
+{
+    return (std::numeric_limits<std::size_t>::max)();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+inline std::size_t addSizes
+(
+    std::size_t lhs,
+    std::size_t rhs
+)
+{
+    return infiniteSize() - lhs < rhs ? infiniteSize() : lhs + rhs;
+}
+
 template<typename T>
 class BetweenGenerator : public IGenerator<T>
 {
@@ -125,17 +146,33 @@ class CompositeGenerator
 public:
     ///////////////////////////////////////////////////////////////////////////
     CompositeGenerator()
-    :   m_totalSize( 0 )
+    :   m_totalSize( 0 ),
+        m_siteId( 0 )
+    {
+    }
+    
+    ///////////////////////////////////////////////////////////////////////////
+    // Like auto_ptr, a copy takes the generators over from the original, so
+    // generators can be returned, and passed to others, by value
+    CompositeGenerator
+    (
+        const CompositeGenerator& other
+    )
+    :   m_composed( other.m_composed ),
+        m_totalSize( other.m_totalSize ),
+        m_siteId( other.m_siteId )
     {
+        other.m_composed.clear();
+        other.m_totalSize = 0;
     }
     
     ///////////////////////////////////////////////////////////////////////////
-    CompositeGenerator& setFileInfo
+    CompositeGenerator& setSiteId
     (
-        const char* fileInfo
+        std::size_t siteId
     )
     {
-        m_fileInfo = fileInfo;
+        m_siteId = siteId;
         return *this;
     }
     
@@ -147,18 +184,32 @@ public:
     }
     
     ///////////////////////////////////////////////////////////////////////////
+    // Every value is run in turn, so there must be a finite number of them -
+    // and at least one
     operator T
     ()
     const
     {
-        size_t overallIndex = Hub::getGeneratorIndex( m_fileInfo, m_totalSize );
-        
+        if( m_totalSize == infiniteSize() )
+            throw std::logic_error( "GENERATE can't run every value of an infinite generator - limit it with take()" );
+        if( m_totalSize == 0 )
+            throw std::logic_error( "GENERATE was given a generator with no values" );
+        return getValue( Hub::getGeneratorIndex( m_siteId, m_totalSize ) );
+    }
+    
+    ///////////////////////////////////////////////////////////////////////////
+    T getValue
+    (
+        std::size_t overallIndex
+    )
+    const
+    {
         typename std::vector<const IGenerator<T>*>::const_iterator it = m_composed.begin();
         typename std::vector<const IGenerator<T>*>::const_iterator itEnd = m_composed.end();
         for( size_t index = 0; it != itEnd; ++it )
         {
             const IGenerator<T>* generator = *it;
-            if( overallIndex >= index && overallIndex < index + generator->size() )
+            if( overallIndex >= index && overallIndex - index < generator->size() )
             {
                 return generator->getValue( overallIndex-index );
             }
@@ -167,13 +218,21 @@ public:
         throw "this should never happen!";
     }
     
+    ///////////////////////////////////////////////////////////////////////////
+    std::size_t size
+    ()
+    const
+    {
+        return m_totalSize;
+    }
+    
     ///////////////////////////////////////////////////////////////////////////
     void add
     (
         const IGenerator<T>* generator
     )
     {
-        m_totalSize += generator->size();
+        m_totalSize = addSizes( m_totalSize, generator->size() );
         m_composed.push_back( generator );
     }
     
@@ -207,14 +266,308 @@ private:
         CompositeGenerator& other
     )
     {
-        std::copy( other.m_composed.begin(), other.m_composed.end(), std::back_inserter( m_composed ) );
-        m_totalSize += other.m_totalSize;
+        m_composed.insert( m_composed.end(), other.m_composed.begin(), other.m_composed.end() );
+        m_totalSize = addSizes( m_totalSize, other.m_totalSize );
         other.m_composed.clear();
+        other.m_totalSize = 0;
+    }
+    
+    void operator=( const CompositeGenerator& );
+    
+    mutable std::vector<const IGenerator<T>*> m_composed;
+    mutable size_t m_totalSize;
+    std::size_t m_siteId;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+// Maps a random 64 bit number onto [min, max]
+template<typename T>
+struct RandomValue
+{
+    static T inRange( RandomNumberGenerator& rng, T min, T max )
+    {
+        unsigned long long range = static_cast<unsigned long long>( max ) - static_cast<unsigned long long>( min ) + 1;
+        return static_cast<T>( static_cast<unsigned long long>( min ) + ( range == 0 ? rng.next() : rng.nextBelow( range ) ) );
+    }
+};
+template<typename T>
+struct RandomFloatingValue
+{
+    static T inRange( RandomNumberGenerator& rng, T min, T max )
+    {
+        // 53 random bits, as a fraction in [0, 1]
+        T fraction = static_cast<T>( rng.next() >> 11 ) / static_cast<T>( ( 1ULL << 53 ) - 1 );
+        return min + ( max - min ) * fraction;
+    }
+};
+template<> struct RandomValue<float> : RandomFloatingValue<float> {};
+template<> struct RandomValue<double> : RandomFloatingValue<double> {};
+template<> struct RandomValue<long double> : RandomFloatingValue<long double> {};
+
+///////////////////////////////////////////////////////////////////////////////
+// An endless stream of values in [min, max]. Each value is worked out from
+// the run's seed and its index alone, so nothing is stored and any value
+// can be revisited
+template<typename T>
+class RandomGenerator : public IGenerator<T>
+{
+public:
+    ///////////////////////////////////////////////////////////////////////////
+    RandomGenerator
+    (
+        T min,
+        T max
+    )
+    :   m_min( min ),
+        m_max( max ),
+        m_seed( Hub::getRngSeed() )
+    {
+    }
+    
+    ///////////////////////////////////////////////////////////////////////////
+    virtual T getValue
+    (
+        std::size_t index
+    )
+    const
+    {
+        RandomNumberGenerator rng( RandomNumberGenerator::mix( m_seed ) ^ index );
+        return RandomValue<T>::inRange( rng, m_min, m_max );
+    }
+    
+    ///////////////////////////////////////////////////////////////////////////
+    virtual std::size_t size
+    ()
+    const
+    {
+        return infiniteSize();
+    }
+    
+private:
+    
+    T m_min;
+    T m_max;
+    unsigned long long m_seed;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+template<typename T>
+class TakeGenerator : public IGenerator<T>
+{
+public:
+    ///////////////////////////////////////////////////////////////////////////
+    TakeGenerator
+    (
+        std::size_t count,
+        const CompositeGenerator<T>& source
+    )
+    :   m_count( count ),
+        m_source( source )
+    {
+    }
+    
+    ///////////////////////////////////////////////////////////////////////////
+    virtual T getValue
+    (
+        std::size_t index
+    )
+    const
+    {
+        return m_source.getValue( index );
+    }
+    
+    ///////////////////////////////////////////////////////////////////////////
+    virtual std::size_t size
+    ()
+    const
+    {
+        return m_count < m_source.size() ? m_count : m_source.size();
+    }
+    
+private:
+    
+    std::size_t m_count;
+    CompositeGenerator<T> m_source;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+template<typename T, typename U, typename Fn>
+class MapGenerator : public IGenerator<T>
+{
+public:
+    ///////////////////////////////////////////////////////////////////////////
+    MapGenerator
+    (
+        Fn fn,
+        const CompositeGenerator<U>& source
+    )
+    :   m_fn( fn ),
+        m_source( source )
+    {
+    }
+    
+    ///////////////////////////////////////////////////////////////////////////
+    virtual T getValue
+    (
+        std::size_t index
+    )
+    const
+    {
+        return m_fn( m_source.getValue( index ) );
+    }
+    
+    ///////////////////////////////////////////////////////////////////////////
+    virtual std::size_t size
+    ()
+    const
+    {
+        return m_source.size();
+    }
+    
+private:
+    
+    Fn m_fn;
+    CompositeGenerator<U> m_source;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+// When one generator's values are asked for in order (as a PROPERTY's trials
+// are), the search for the next match carries on from the last one. A
+// GENERATE builds its generators afresh on each run of the test case, though,
+// so there every run scans from the start: filtering n values that way costs
+// O(n^2) calls of the predicate. An infinite source must keep matching - after
+// MaxMisses values in a row that don't, the search gives up
+template<typename T, typename Pred>
+class FilterGenerator : public IGenerator<T>
+{
+public:
+    ///////////////////////////////////////////////////////////////////////////
+    FilterGenerator
+    (
+        Pred pred,
+        const CompositeGenerator<T>& source
+    )
+    :   m_pred( pred ),
+        m_source( source ),
+        m_size( 0 ),
+        m_sizeKnown( false ),
+        m_lastIndex( 0 ),
+        m_lastSourceIndex( 0 ),
+        m_hasLast( false )
+    {
+    }
+    
+    ///////////////////////////////////////////////////////////////////////////
+    virtual T getValue
+    (
+        std::size_t index
+    )
+    const
+    {
+        if( !m_hasLast || index < m_lastIndex )
+        {
+            m_lastSourceIndex = nextMatch( 0 );
+            m_lastIndex = 0;
+            m_hasLast = true;
+        }
+        for(; m_lastIndex < index; ++m_lastIndex )
+            m_lastSourceIndex = nextMatch( m_lastSourceIndex+1 );
+        return m_source.getValue( m_lastSourceIndex );
+    }
+    
+    ///////////////////////////////////////////////////////////////////////////
+    virtual std::size_t size
+    ()
+    const
+    {
+        if( !m_sizeKnown )
+        {
+            // Without looking at every value there's no telling how many match
+            if( m_source.size() == infiniteSize() )
+            {
+                m_size = infiniteSize();
+            }
+            else
+            {
+                m_size = 0;
+                for( std::size_t i = 0; i < m_source.size(); ++i )
+                    if( m_pred( m_source.getValue( i ) ) )
+                        ++m_size;
+            }
+            m_sizeKnown = true;
+        }
+        return m_size;
     }
     
-    std::vector<const IGenerator<T>*> m_composed;
-    std::string m_fileInfo;
-    size_t m_totalSize;
+private:
+    
+    enum { MaxMisses = 100000 };
+
+    ///////////////////////////////////////////////////////////////////////////
+    std::size_t nextMatch
+    (
+        std::size_t sourceIndex
+    )
+    const
+    {
+        for( std::size_t misses = 0; !m_pred( m_source.getValue( sourceIndex ) ); ++sourceIndex )
+            if( ++misses == MaxMisses && m_source.size() == infiniteSize() )
+                throw std::logic_error( "filter() found no match in 100000 values of an infinite generator" );
+        return sourceIndex;
+    }
+    
+    Pred m_pred;
+    CompositeGenerator<T> m_source;
+    mutable std::size_t m_size;
+    mutable bool m_sizeKnown;
+    mutable std::size_t m_lastIndex;
+    mutable std::size_t m_lastSourceIndex;
+    mutable bool m_hasLast;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+template<typename T>
+class ChunkGenerator : public IGenerator<std::vector<T> >
+{
+public:
+    ///////////////////////////////////////////////////////////////////////////
+    ChunkGenerator
+    (
+        std::size_t chunkSize,
+        const CompositeGenerator<T>& source
+    )
+    :   m_chunkSize( chunkSize > 0 ? chunkSize : 1 ),
+        m_source( source )
+    {
+    }
+    
+    ///////////////////////////////////////////////////////////////////////////
+    virtual std::vector<T> getValue
+    (
+        std::size_t index
+    )
+    const
+    {
+        std::vector<T> chunk;
+        chunk.reserve( m_chunkSize );
+        for( std::size_t i = 0; i < m_chunkSize; ++i )
+            chunk.push_back( m_source.getValue( index * m_chunkSize + i ) );
+        return chunk;
+    }
+    
+    ///////////////////////////////////////////////////////////////////////////
+    virtual std::size_t size
+    ()
+    const
+    {
+        // Any incomplete chunk at the end is left out
+        return m_source.size() == infiniteSize() ? infiniteSize() : m_source.size() / m_chunkSize;
+    }
+    
+private:
+    
+    std::size_t m_chunkSize;
+    CompositeGenerator<T> m_source;
 };
 
 namespace Generators
@@ -286,15 +639,117 @@ namespace Generators
         return generators;
     }
 
+    ///////////////////////////////////////////////////////////////////////////
+    // Never runs out - use take() to say how many values are wanted
+    template<typename T>
+    CompositeGenerator<T> random
+    (
+        T min,
+        T max
+    )
+    {
+        CompositeGenerator<T> generators;
+        generators.add( new RandomGenerator<T>( min, max ) );
+        return generators;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    template<typename T>
+    CompositeGenerator<T> take
+    (
+        std::size_t count,
+        CompositeGenerator<T> source
+    )
+    {
+        CompositeGenerator<T> generators;
+        generators.add( new TakeGenerator<T>( count, source ) );
+        return generators;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    template<typename T, typename U>
+    CompositeGenerator<T> map
+    (
+        T (*fn)( U ),
+        CompositeGenerator<U> source
+    )
+    {
+        CompositeGenerator<T> generators;
+        generators.add( new MapGenerator<T, U, T (*)( U )>( fn, source ) );
+        return generators;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // For function objects, the result type has to be given: map<T>( fn, source )
+    template<typename T, typename U, typename Fn>
+    CompositeGenerator<T> map
+    (
+        Fn fn,
+        CompositeGenerator<U> source
+    )
+    {
+        CompositeGenerator<T> generators;
+        generators.add( new MapGenerator<T, U, Fn>( fn, source ) );
+        return generators;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    template<typename T, typename Pred>
+    CompositeGenerator<T> filter
+    (
+        Pred pred,
+        CompositeGenerator<T> source
+    )
+    {
+        CompositeGenerator<T> generators;
+        generators.add( new FilterGenerator<T, Pred>( pred, source ) );
+        return generators;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    template<typename T>
+    CompositeGenerator<std::vector<T> > chunk
+    (
+        std::size_t chunkSize,
+        CompositeGenerator<T> source
+    )
+    {
+        CompositeGenerator<std::vector<T> > generators;
+        generators.add( new ChunkGenerator<T>( chunkSize, source ) );
+        return generators;
+    }
+
 } // end namespace Generators
     
 using namespace Generators;
+
+namespace
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // Gives each GENERATE a program-wide id, allocated the first time it is
+    // reached. Each translation unit has its own instantiations, so the
+    // per-file counter is enough to tell call sites apart
+    template<int N>
+    struct GeneratorSite
+    {
+        static std::size_t id
+        ()
+        {
+            static const std::size_t siteId = Hub::allocateGeneratorSiteId();
+            return siteId;
+        }
+    };
+}
     
 } // end namespace Catch
 
-#define INTERNAL_CATCH_LINESTR2( line ) #line
-#define INTERNAL_CATCH_LINESTR( line ) INTERNAL_CATCH_LINESTR2( line )
+#ifdef __COUNTER__
+    #define INTERNAL_CATCH_GENERATOR_SITE_ID Catch::GeneratorSite<__COUNTER__>::id()
+#else
+    // Two GENERATEs on one line would share an id
+    #define INTERNAL_CATCH_GENERATOR_SITE_ID Catch::GeneratorSite<__LINE__>::id()
+#endif
 
-#define INTERNAL_CATCH_GENERATE( expr ) expr.setFileInfo( __FILE__ "(" INTERNAL_CATCH_LINESTR( __LINE__ ) ")" )
+#define INTERNAL_CATCH_GENERATE( expr ) expr.setSiteId( INTERNAL_CATCH_GENERATOR_SITE_ID )
 
 #endif // TWOBLUECUBES_CATCH_GENERATORS_HPP_INCLUDED
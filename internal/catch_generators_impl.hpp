@@ -14,10 +14,12 @@
 #define TWOBLUECUBES_CATCH_GENERATORS_IMPL_HPP_INCLUDED
 
 #include "catch_common.h"
+#include "catch_pairwise.hpp"
 
 #include <vector>
-#include <string>
-#include <map>
+#include <limits>
+#include <algorithm>
+#include <stdexcept>
 
 namespace Catch
 {
@@ -45,6 +47,15 @@ namespace Catch
             return true;
         }
         
+        ///////////////////////////////////////////////////////////////////////        
+        void setCurrentIndex
+        (
+            std::size_t index
+        )
+        {
+            m_currentIndex = index;
+        }
+        
         ///////////////////////////////////////////////////////////////////////        
         std::size_t getCurrentIndex
         ()
@@ -60,10 +71,36 @@ namespace Catch
     ///////////////////////////////////////////////////////////////////////////
     ///////////////////////////////////////////////////////////////////////////
     
-    class GeneratorsForTest
+    // How the values of several generators in one test case are combined:
+    // every combination, or just enough to see every pair of values together
+    struct Combination { enum What
+    {
+        AllCombinations,
+        Pairwise
+    }; };
+    
+    ///////////////////////////////////////////////////////////////////////////
+    ///////////////////////////////////////////////////////////////////////////
+    
+    // The position of each generator used by one run of a test case. Generators
+    // are found by the id of their call site, so this is a straight index
+    class GeneratorsForTest : NonCopyable
     {
         
     public:
+        ///////////////////////////////////////////////////////////////////////        
+        explicit GeneratorsForTest
+        (
+            Combination::What combination = Combination::AllCombinations
+        )
+        :   m_combination( combination ),
+            m_rowsGeneratorCount( 0 ),
+            m_currentRow( 0 ),
+            m_isCopy( false ),
+            m_sawUnknownSite( false )
+        {
+        }
+        
         ///////////////////////////////////////////////////////////////////////        
         ~GeneratorsForTest
         ()
@@ -74,25 +111,36 @@ namespace Catch
         ///////////////////////////////////////////////////////////////////////        
         GeneratorInfo& getGeneratorInfo
         (
-            const std::string& fileInfo,
+            std::size_t siteId,
             std::size_t size
         )
         {
-            std::map<std::string, GeneratorInfo*>::const_iterator it = m_generatorsByName.find( fileInfo );
-            if( it == m_generatorsByName.end() )
+            if( siteId >= m_generatorsBySite.size() )
+                m_generatorsBySite.resize( siteId+1, NULL );
+            GeneratorInfo*& info = m_generatorsBySite[siteId];
+            if( !info )
             {
-                GeneratorInfo* info = new GeneratorInfo( size );
-                m_generatorsByName.insert( std::make_pair( fileInfo, info ) );
+                // A copy can only run the combinations of the generators it
+                // was given - one more would need combinations nobody is running
+                if( m_isCopy )
+                {
+                    m_sawUnknownSite = true;
+                    throw std::logic_error( "A GENERATE was reached that the first run of the test case didn't reach, "
+                                            "so its values can't be shared out between threads. Run this test case without --generator-threads" );
+                }
+                info = new GeneratorInfo( size );
                 m_generatorsInOrder.push_back( info );
-                return *info;
             }
-            return *it->second;
+            return *info;
         }
         
         ///////////////////////////////////////////////////////////////////////        
         bool moveNext
         ()
         {
+            if( m_combination == Combination::Pairwise )
+                return moveNextPair();
+            
             std::vector<GeneratorInfo*>::const_iterator it = m_generatorsInOrder.begin();
             std::vector<GeneratorInfo*>::const_iterator itEnd = m_generatorsInOrder.end();
             for(; it != itEnd; ++it )
@@ -103,16 +151,123 @@ namespace Catch
             return false;
         }
         
+        ///////////////////////////////////////////////////////////////////////        
+        // How many runs it takes to get through the generators seen so far.
+        // Each run is numbered, from zero, and can be moved to directly
+        std::size_t getCombinationCount
+        ()
+        {
+            if( m_combination == Combination::Pairwise )
+            {
+                updateRows();
+                return m_rows.size();
+            }
+            
+            std::size_t count = 1;
+            for( std::size_t i = 0; i < m_generatorsInOrder.size(); ++i )
+            {
+                std::size_t size = m_generatorsInOrder[i]->m_size;
+                if( size > 0 && count > (std::numeric_limits<std::size_t>::max)() / size )
+                    return (std::numeric_limits<std::size_t>::max)();
+                count *= size;
+            }
+            return count;
+        }
+        
+        ///////////////////////////////////////////////////////////////////////        
+        void moveTo
+        (
+            std::size_t combination
+        )
+        {
+            if( m_combination == Combination::Pairwise )
+            {
+                updateRows();
+                for( std::size_t i = 0; i < m_generatorsInOrder.size(); ++i )
+                    m_generatorsInOrder[i]->setCurrentIndex( m_rows[combination][i] );
+                return;
+            }
+            
+            // The first generator moves fastest, as with moveNext()
+            for( std::size_t i = 0; i < m_generatorsInOrder.size(); ++i )
+            {
+                std::size_t size = m_generatorsInOrder[i]->m_size;
+                m_generatorsInOrder[i]->setCurrentIndex( combination % size );
+                combination /= size;
+            }
+        }
+        
+        ///////////////////////////////////////////////////////////////////////        
+        // Takes on the generators another has seen, each at its first value,
+        // so runs can be shared out between several
+        void copyGeneratorsFrom
+        (
+            const GeneratorsForTest& other
+        )
+        {
+            m_isCopy = true;
+            m_combination = other.m_combination;
+            m_generatorsBySite.assign( other.m_generatorsBySite.size(), NULL );
+            for( std::size_t i = 0; i < other.m_generatorsInOrder.size(); ++i )
+            {
+                m_generatorsInOrder.push_back( new GeneratorInfo( other.m_generatorsInOrder[i]->m_size ) );
+                std::size_t siteId = std::find( other.m_generatorsBySite.begin(), other.m_generatorsBySite.end(), other.m_generatorsInOrder[i] ) - other.m_generatorsBySite.begin();
+                m_generatorsBySite[siteId] = m_generatorsInOrder.back();
+            }
+        }
+        
+        ///////////////////////////////////////////////////////////////////////        
+        // True if a copy has been asked for a generator it wasn't given
+        bool sawUnknownSite
+        ()
+        const
+        {
+            return m_sawUnknownSite;
+        }
+        
     private:
-        std::map<std::string, GeneratorInfo*> m_generatorsByName;
+        ///////////////////////////////////////////////////////////////////////        
+        // Generators are only found as the test runs, so the rows are worked
+        // out after the first run (which is the all-zeros first row) - and
+        // again, starting over, if a run turns up another generator
+        bool moveNextPair
+        ()
+        {
+            if( updateRows() )
+                m_currentRow = 0;
+            
+            bool more = ++m_currentRow < m_rows.size();
+            for( std::size_t i = 0; i < m_generatorsInOrder.size(); ++i )
+                m_generatorsInOrder[i]->setCurrentIndex( more ? m_rows[m_currentRow][i] : 0 );
+            return more;
+        }
+        
+        ///////////////////////////////////////////////////////////////////////        
+        // Returns true if the rows had to be worked out again
+        bool updateRows
+        ()
+        {
+            if( m_generatorsInOrder.size() == m_rowsGeneratorCount )
+                return false;
+            
+            std::vector<std::size_t> sizes;
+            for( std::size_t i = 0; i < m_generatorsInOrder.size(); ++i )
+                sizes.push_back( m_generatorsInOrder[i]->m_size );
+            m_rows = makePairwiseCoveringArray( sizes );
+            m_rowsGeneratorCount = m_generatorsInOrder.size();
+            return true;
+        }
+        
+        Combination::What m_combination;
+        std::vector<GeneratorInfo*> m_generatorsBySite;
         std::vector<GeneratorInfo*> m_generatorsInOrder;
+        std::vector<std::vector<std::size_t> > m_rows;
+        std::size_t m_rowsGeneratorCount;
+        std::size_t m_currentRow;
+        bool m_isCopy;
+        bool m_sawUnknownSite;
     };
     
 } // end namespace Catch
 
-#define INTERNAL_CATCH_LINESTR2( line ) #line
-#define INTERNAL_CATCH_LINESTR( line ) INTERNAL_CATCH_LINESTR2( line )
-
-#define INTERNAL_CATCH_GENERATE( expr ) expr.setFileInfo( __FILE__ "(" INTERNAL_CATCH_LINESTR( __LINE__ ) ")" )
-
 #endif // TWOBLUECUBES_CATCH_GENERATORS_HPP_INCLUDED
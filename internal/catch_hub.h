@@ -12,10 +12,9 @@
 #ifndef TWOBLUECUBES_CATCH_HUB_H_INCLUDED
 #define TWOBLUECUBES_CATCH_HUB_H_INCLUDED
 
-#include "catch_interfaces_reporter.h"
-
-#include <memory>
+#include <streambuf>
 #include <vector>
+#include <string>
 #include <stdlib.h>
 
 namespace Catch
@@ -24,15 +23,68 @@ namespace Catch
     struct IResultCapture;
     struct ITestCaseRegistry;
     struct IRunner;
+    struct IReporterRegistry;
     class GeneratorsForTest;
+    class MessageStream;
 
     class StreamBufBase : public std::streambuf
     {
     };
     
+    // Everything specific to one run of the tests. Each thread reports to the
+    // context it entered. A Catch::Thread enters the context of the thread
+    // that started it; other threads must enter one before asserting
+    class HubContext
+    {
+        HubContext( const HubContext& );
+        void operator=( const HubContext& );
+        friend class Hub;
+    public:
+        HubContext
+            (   IRunner* runner,
+                IResultCapture* resultCapture
+            );
+        
+        ~HubContext
+            ();
+        
+        // The generator positions for the test case being run, if any
+        void setGenerators
+            (   GeneratorsForTest* generators
+            );
+        
+        void setRngSeed
+            (   unsigned int seed
+            );
+        
+        // The default relative tolerance for Approx. Zero for its own default
+        void setFpTolerance
+            (   double epsilon
+            );
+        
+        // Whether anything has asked for the seed - i.e. used randomness -
+        // since this was last set to false
+        bool wasRngSeedUsed
+            () const;
+        
+        void setRngSeedUsed
+            (   bool used
+            );
+        
+    private:
+        IRunner* m_runner;
+        IResultCapture* m_resultCapture;
+        GeneratorsForTest* m_generators;
+        unsigned int m_rngSeed;
+        bool m_rngSeedUsed;
+        double m_fpTolerance;
+    };
+    
     class Hub
     {
         Hub();
+        Hub( const Hub& );
+        void operator=( const Hub& );
 
         ~Hub();
         
@@ -40,14 +92,21 @@ namespace Catch
         
     public:
         
-        static void setRunner
-            ( IRunner* runner 
+        // Returns the context the current thread was in before, to be passed
+        // back to leaveContext
+        static HubContext* enterContext
+            ( HubContext* context
             );
         
-        static void setResultCapture
-            ( IResultCapture* resultCapture 
+        static void leaveContext
+            (   HubContext* context,
+                HubContext* prevContext
             );
         
+        // The context this thread entered, or NULL if it hasn't entered one
+        static HubContext* findCurrentContext
+            ();
+        
         static IResultCapture& getResultCapture
             ();
         
@@ -65,25 +124,32 @@ namespace Catch
             ();
         
         static size_t getGeneratorIndex
-            (   const std::string& fileInfo, 
+            (   std::size_t siteId, 
                 size_t totalSize 
             );
         
-        static bool advanceGeneratorsForCurrentTest
+        static std::size_t allocateGeneratorSiteId
             ();
         
-    private:
-        GeneratorsForTest* findGeneratorsForCurrentTest
+        static unsigned int getRngSeed
             ();
         
-        GeneratorsForTest& getGeneratorsForCurrentTest
+        static double getFpTolerance
             ();
         
-        std::auto_ptr<IReporterRegistry> m_reporterRegistry;
-        std::auto_ptr<ITestCaseRegistry> m_testCaseRegistry;
-        IRunner* m_runner;
-        IResultCapture* m_resultCapture;
-        std::map<std::string, GeneratorsForTest*> m_generatorsByTestName;
+        // This thread's stream for messages, emptied ready for the next one
+        static MessageStream& getMessageStream
+            ();
+        
+    private:
+        // Throws if this thread hasn't entered a context
+        static HubContext& getCurrentContext
+            ();
+        
+        // Owned. Not auto_ptrs, so <memory> isn't needed by every test file
+        IReporterRegistry* m_reporterRegistry;
+        ITestCaseRegistry* m_testCaseRegistry;
+        std::size_t m_generatorSiteCount;
     };
 }
 
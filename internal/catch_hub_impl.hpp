@@ -9,12 +9,20 @@
  *  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
  *
  */
+#ifndef TWOBLUECUBES_CATCH_HUB_IMPL_HPP_INCLUDED
+#define TWOBLUECUBES_CATCH_HUB_IMPL_HPP_INCLUDED
+
 #include "catch_hub.h"
 #include "catch_reporter_registry.hpp"
 #include "catch_test_case_registry_impl.hpp"
 #include "catch_runner_impl.hpp"
 #include "catch_generators_impl.hpp"
+#include "catch_property_impl.hpp"
+#include "catch_capture_impl.hpp"
 #include "catch_stream.hpp"
+#include "catch_thread.hpp"
+
+#include <stdexcept>
 
 namespace Catch
 {    
@@ -22,7 +30,8 @@ namespace Catch
     Hub::Hub
     ()
     :   m_reporterRegistry( new ReporterRegistry ),
-        m_testCaseRegistry( new TestRegistry )
+        m_testCaseRegistry( new TestRegistry ),
+        m_generatorSiteCount( 0 )
     {
     }
 
@@ -30,11 +39,8 @@ namespace Catch
     Hub::~Hub
     ()
     {
-        while(!m_generatorsByTestName.empty())
-        {
-            delete m_generatorsByTestName.begin()->second;
-            m_generatorsByTestName.erase(m_generatorsByTestName.begin());
-        }
+        delete m_testCaseRegistry;
+        delete m_reporterRegistry;
     }
 
     ///////////////////////////////////////////////////////////////////////////
@@ -45,43 +51,165 @@ namespace Catch
         return hub;
     }
 
+    namespace
+    {
+        ///////////////////////////////////////////////////////////////////////////
+        ThreadLocal<HubContext*>& currentContextForThread
+        ()
+        {
+            static ThreadLocal<HubContext*> context;
+            return context;
+        }
+
+        ///////////////////////////////////////////////////////////////////////////
+        ThreadLocal<MessageStream>& messageStreamForThread
+        ()
+        {
+            static ThreadLocal<MessageStream> stream;
+            return stream;
+        }
+
+        ///////////////////////////////////////////////////////////////////////////
+        // Guards the Hub's state that can change while tests are running
+        Mutex& hubMutex
+        ()
+        {
+            static Mutex mutex;
+            return mutex;
+        }
+    }
+
     ///////////////////////////////////////////////////////////////////////////
-    void Hub::setRunner( IRunner* runner )
+    HubContext::HubContext
+    (
+        IRunner* runner,
+        IResultCapture* resultCapture
+    )
+    :   m_runner( runner ),
+        m_resultCapture( resultCapture ),
+        m_generators( NULL ),
+        m_rngSeed( 0 ),
+        m_rngSeedUsed( false ),
+        m_fpTolerance( 0 )
     {
-        me().m_runner = runner;
     }
+
     ///////////////////////////////////////////////////////////////////////////
-    void Hub::setResultCapture( IResultCapture* resultCapture )
+    HubContext::~HubContext
+    ()
     {
-        me().m_resultCapture = resultCapture;
     }
-    
+
+    ///////////////////////////////////////////////////////////////////////////
+    void HubContext::setGenerators
+    (
+        GeneratorsForTest* generators
+    )
+    {
+        m_generators = generators;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    void HubContext::setRngSeed
+    (
+        unsigned int seed
+    )
+    {
+        m_rngSeed = seed;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    void HubContext::setFpTolerance
+    (
+        double epsilon
+    )
+    {
+        m_fpTolerance = epsilon;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    bool HubContext::wasRngSeedUsed
+    ()
+    const
+    {
+        return m_rngSeedUsed;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    void HubContext::setRngSeedUsed
+    (
+        bool used
+    )
+    {
+        m_rngSeedUsed = used;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    HubContext* Hub::enterContext
+    (
+        HubContext* context
+    )
+    {
+        HubContext*& current = currentContextForThread().get();
+        HubContext* prevContext = current;
+        current = context;
+        return prevContext;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    void Hub::leaveContext
+    (
+        HubContext*,
+        HubContext* prevContext
+    )
+    {
+        currentContextForThread().get() = prevContext;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    HubContext* Hub::findCurrentContext
+    ()
+    {
+        HubContext** current = currentContextForThread().find();
+        return current ? *current : NULL;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    HubContext& Hub::getCurrentContext
+    ()
+    {
+        if( HubContext* current = findCurrentContext() )
+            return *current;
+        throw std::logic_error( "Assertion made from a thread that isn't part of a test run. "
+                                "Start threads with Catch::Thread, or have them call Hub::enterContext" );
+    }
+
     ///////////////////////////////////////////////////////////////////////////
     IResultCapture& Hub::getResultCapture
     ()
     {
-        return *me().m_resultCapture;
+        return *getCurrentContext().m_resultCapture;
     }
 
     ///////////////////////////////////////////////////////////////////////////
     IRunner& Hub::getRunner
     ()
     {
-        return *me().m_runner;
+        return *getCurrentContext().m_runner;
     }
     
     ///////////////////////////////////////////////////////////////////////////
     IReporterRegistry& Hub::getReporterRegistry
     ()
     {
-        return *me().m_reporterRegistry.get();
+        return *me().m_reporterRegistry;
     }
 
     ///////////////////////////////////////////////////////////////////////////
     ITestCaseRegistry& Hub::getTestCaseRegistry
     ()
     {
-        return *me().m_testCaseRegistry.get();
+        return *me().m_testCaseRegistry;
     }
     
     ///////////////////////////////////////////////////////////////////////////
@@ -98,48 +226,53 @@ namespace Catch
     }
 
     ///////////////////////////////////////////////////////////////////////////
-    GeneratorsForTest* Hub::findGeneratorsForCurrentTest
+    size_t Hub::getGeneratorIndex
+    (
+        std::size_t siteId, 
+        size_t totalSize 
+    )
+    {
+        HubContext* context = findCurrentContext();
+        if( !context || !context->m_generators )
+            return 0;
+        return context->m_generators->getGeneratorInfo( siteId, totalSize ).getCurrentIndex();
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    std::size_t Hub::allocateGeneratorSiteId
     ()
     {
-        std::string testName = getResultCapture().getCurrentTestName();
-        
-        std::map<std::string, GeneratorsForTest*>::const_iterator it = 
-            m_generatorsByTestName.find( testName );
-        return it != m_generatorsByTestName.end()
-            ? it->second
-            : NULL;
+        ScopedLock lock( hubMutex() );
+        return me().m_generatorSiteCount++;
     }
+
     ///////////////////////////////////////////////////////////////////////////
-    GeneratorsForTest& Hub::getGeneratorsForCurrentTest
+    unsigned int Hub::getRngSeed
     ()
     {
-        GeneratorsForTest* generators = findGeneratorsForCurrentTest();
-        if( !generators )
-        {
-            std::string testName = getResultCapture().getCurrentTestName();
-            generators = new GeneratorsForTest();
-            m_generatorsByTestName.insert( std::make_pair( testName, generators ) );
-        }
-        return *generators;
+        HubContext* context = findCurrentContext();
+        if( !context )
+            return 0;
+        context->m_rngSeedUsed = true;
+        return context->m_rngSeed;
     }
-    
+
     ///////////////////////////////////////////////////////////////////////////
-    size_t Hub::getGeneratorIndex
-    (
-        const std::string& fileInfo, 
-        size_t totalSize 
-    )
+    double Hub::getFpTolerance
+    ()
     {
-        return me().getGeneratorsForCurrentTest()
-            .getGeneratorInfo( fileInfo, totalSize )
-            .getCurrentIndex();
+        HubContext* context = findCurrentContext();
+        return context ? context->m_fpTolerance : 0;
     }
 
     ///////////////////////////////////////////////////////////////////////////
-    bool Hub::advanceGeneratorsForCurrentTest
+    MessageStream& Hub::getMessageStream
     ()
     {
-        GeneratorsForTest* generators = me().findGeneratorsForCurrentTest();
-        return generators && generators->moveNext();
+        MessageStream& stream = messageStreamForThread().get();
+        stream.reset();
+        return stream;
     }
 }
+
+#endif // TWOBLUECUBES_CATCH_HUB_IMPL_HPP_INCLUDED
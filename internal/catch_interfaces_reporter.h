@@ -33,6 +33,10 @@ namespace Catch
         
         virtual bool includeSuccessfulResults
             () const = 0;
+        
+        // Zero if nothing is being randomised
+        virtual unsigned int rngSeed
+            () const { return 0; }
     };
     
     class TestCaseInfo;
@@ -14,58 +14,237 @@
 #define TWOBLUECUBES_CATCH_LIST_HPP_INCLUDED
 
 #include "catch_commandline.hpp"
+#include "catch_run_state.hpp"
+#include "catch_xmlwriter.hpp"
+#include <cstdio>
 #include <limits>
+#include <sstream>
 
 namespace Catch
 {
-    ///////////////////////////////////////////////////////////////////////////
-    inline int List
-    (
-        const Config& config
-    )
+    // The listings are built up in memory, then written in one go - tools
+    // that list huge numbers of tests (e.g. to plan shards) shouldn't have to
+    // wait on a write per line. The xml and json listings include, for each
+    // test, where it was registered, its tags and - if there is a --state
+    // file - how long it took last time
+    namespace Detail
     {
-        if( config.listWhat() & Config::List::Reports )
+        ///////////////////////////////////////////////////////////////////////
+        inline void listAsText
+        (
+            const Config& config,
+            std::ostream& os
+        )
         {
-            std::cout << "Available reports:\n";
-            IReporterRegistry::FactoryMap::const_iterator it = Hub::getReporterRegistry().getFactories().begin();
-            IReporterRegistry::FactoryMap::const_iterator itEnd = Hub::getReporterRegistry().getFactories().end();
-            for(; it != itEnd; ++it )
+            if( config.listWhat() & Config::List::Reports )
             {
-                // !TBD: consider listAs()
-                std::cout << "\t" << it->first << "\n\t\t'" << it->second->getDescription() << "'\n";
+                os << "Available reports:\n";
+                IReporterRegistry::FactoryMap::const_iterator it = Hub::getReporterRegistry().getFactories().begin();
+                IReporterRegistry::FactoryMap::const_iterator itEnd = Hub::getReporterRegistry().getFactories().end();
+                for(; it != itEnd; ++it )
+                    os << "\t" << it->first << "\n\t\t'" << it->second->getDescription() << "'\n";
+                os << "\n";
+            }
+            if( config.listWhat() & Config::List::Tests )
+            {
+                os << "Available tests:\n";
+                std::vector<TestCaseInfo>::const_iterator it = Hub::getTestCaseRegistry().getAllTests().begin();
+                std::vector<TestCaseInfo>::const_iterator itEnd = Hub::getTestCaseRegistry().getAllTests().end();
+                for(; it != itEnd; ++it )
+                    os << "\t" << it->getName() << "\n\t\t '" << it->getDescription() << "'\n";
+                os << "\n";
             }
-            std::cout << std::endl;
         }
-        if( config.listWhat() & Config::List::Tests )
+
+        ///////////////////////////////////////////////////////////////////////
+        inline void listAsXml
+        (
+            const Config& config,
+            const RunState* state,
+            std::ostream& os
+        )
         {
-            std::cout << "Available tests:\n";
-            std::vector<TestCaseInfo>::const_iterator it = Hub::getTestCaseRegistry().getAllTests().begin();
-            std::vector<TestCaseInfo>::const_iterator itEnd = Hub::getTestCaseRegistry().getAllTests().end();
-            for(; it != itEnd; ++it )
+            XmlWriter xml( os );
+            xml.startElement( "Catch" );
+            if( config.listWhat() & Config::List::Reports )
             {
-                // !TBD: consider listAs()
-                std::cout << "\t" << it->getName() << "\n\t\t '" << it->getDescription() << "'\n";
+                XmlWriter::ScopedElement reporters = xml.scopedElement( "Reporters" );
+                IReporterRegistry::FactoryMap::const_iterator it = Hub::getReporterRegistry().getFactories().begin();
+                IReporterRegistry::FactoryMap::const_iterator itEnd = Hub::getReporterRegistry().getFactories().end();
+                for(; it != itEnd; ++it )
+                    xml.scopedElement( "Reporter" )
+                        .writeAttribute( "name", it->first )
+                        .writeAttribute( "description", it->second->getDescription() );
             }
-            std::cout << std::endl;
+            if( config.listWhat() & Config::List::Tests )
+            {
+                XmlWriter::ScopedElement testCases = xml.scopedElement( "TestCases" );
+                std::vector<TestCaseInfo>::const_iterator it = Hub::getTestCaseRegistry().getAllTests().begin();
+                std::vector<TestCaseInfo>::const_iterator itEnd = Hub::getTestCaseRegistry().getAllTests().end();
+                for(; it != itEnd; ++it )
+                {
+                    XmlWriter::ScopedElement testCase = xml.scopedElement( "TestCase" );
+                    testCase.writeAttribute( "name", it->getName() )
+                        .writeAttribute( "description", it->getDescription() );
+                    if( !it->getFilename().empty() )
+                        testCase.writeAttribute( "filename", it->getFilename() )
+                            .writeAttribute( "line", it->getLine() );
+                    unsigned long long durationMs = 0;
+                    if( state && state->getDuration( it->getName(), durationMs ) )
+                        testCase.writeAttribute( "durationMs", durationMs );
+
+                    std::vector<std::string> tags = it->getTags();
+                    for( std::size_t i = 0; i < tags.size(); ++i )
+                        xml.scopedElement( "Tag" ).writeAttribute( "name", tags[i] );
+                }
+            }
+            xml.endElement();
         }
+
+        ///////////////////////////////////////////////////////////////////////
+        inline void writeJsonString
+        (
+            std::ostream& os,
+            const std::string& str
+        )
+        {
+            os << '"';
+            for( std::size_t i = 0; i < str.size(); ++i )
+            {
+                char c = str[i];
+                switch( c )
+                {
+                    case '"':   os << "\\\"";   break;
+                    case '\\':  os << "\\\\";   break;
+                    case '\n':  os << "\\n";    break;
+                    case '\r':  os << "\\r";    break;
+                    case '\t':  os << "\\t";    break;
+                    default:
+                        if( static_cast<unsigned char>( c ) < 0x20 )
+                        {
+                            char escaped[8];
+                            std::sprintf( escaped, "\\u%04x", static_cast<unsigned int>( c ) );
+                            os << escaped;
+                        }
+                        else
+                        {
+                            os << c;
+                        }
+                }
+            }
+            os << '"';
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        inline void listAsJson
+        (
+            const Config& config,
+            const RunState* state,
+            std::ostream& os
+        )
+        {
+            os << "{";
+            const char* separator = "\n";
+            if( config.listWhat() & Config::List::Reports )
+            {
+                os << separator << "  \"reporters\": [";
+                IReporterRegistry::FactoryMap::const_iterator it = Hub::getReporterRegistry().getFactories().begin();
+                IReporterRegistry::FactoryMap::const_iterator itEnd = Hub::getReporterRegistry().getFactories().end();
+                for( const char* comma = "\n"; it != itEnd; ++it, comma = ",\n" )
+                {
+                    os << comma << "    { \"name\": ";
+                    writeJsonString( os, it->first );
+                    os << ", \"description\": ";
+                    writeJsonString( os, it->second->getDescription() );
+                    os << " }";
+                }
+                os << "\n  ]";
+                separator = ",\n";
+            }
+            if( config.listWhat() & Config::List::Tests )
+            {
+                os << separator << "  \"tests\": [";
+                std::vector<TestCaseInfo>::const_iterator it = Hub::getTestCaseRegistry().getAllTests().begin();
+                std::vector<TestCaseInfo>::const_iterator itEnd = Hub::getTestCaseRegistry().getAllTests().end();
+                for( const char* comma = "\n"; it != itEnd; ++it, comma = ",\n" )
+                {
+                    os << comma << "    { \"name\": ";
+                    writeJsonString( os, it->getName() );
+                    os << ", \"description\": ";
+                    writeJsonString( os, it->getDescription() );
+                    os << ", \"tags\": [";
+                    std::vector<std::string> tags = it->getTags();
+                    for( std::size_t i = 0; i < tags.size(); ++i )
+                    {
+                        os << ( i > 0 ? ", " : " " );
+                        writeJsonString( os, tags[i] );
+                    }
+                    os << ( tags.empty() ? "]" : " ]" );
+                    if( !it->getFilename().empty() )
+                    {
+                        os << ", \"filename\": ";
+                        writeJsonString( os, it->getFilename() );
+                        os << ", \"line\": " << it->getLine();
+                    }
+                    unsigned long long durationMs = 0;
+                    if( state && state->getDuration( it->getName(), durationMs ) )
+                        os << ", \"durationMs\": " << durationMs;
+                    os << " }";
+                }
+                os << "\n  ]";
+            }
+            os << "\n}\n";
+        }
+
+    } // end namespace Detail
+
+    ///////////////////////////////////////////////////////////////////////////
+    inline int List
+    (
+        const Config& config
+    )
+    {
         if( ( config.listWhat() & Config::List::All ) == 0 )
         {
             std::cerr << "Unknown list type" << std::endl;
             return std::numeric_limits<int>::max();
         }
-        
+
+        // Durations are only given if there is a state file to get them from
+        RunState state;
+        const RunState* statePtr = NULL;
+        if( !config.getStateFilename().empty() && state.load( config.getStateFilename() ) )
+            statePtr = &state;
+
+        std::ostringstream oss;
+        switch( config.listAs() )
+        {
+            case Config::List::AsXml:
+                Detail::listAsXml( config, statePtr, oss );
+                break;
+            case Config::List::AsJson:
+                Detail::listAsJson( config, statePtr, oss );
+                break;
+            default:
+                Detail::listAsText( config, oss );
+                break;
+        }
+        std::string listing = oss.str();
+        std::cout.write( listing.data(), static_cast<std::streamsize>( listing.size() ) );
+        std::cout.flush();
+
         if( config.getReporter() )
         {
             std::cerr << "Reporters ignored when listing" << std::endl;
         }
-        if( !config.testsSpecified() )
+        if( config.testsSpecified() )
         {
             std::cerr << "Test specs ignored when listing" << std::endl;
         }
         return 0;
 
     }
-    
+
 } // end namespace Catch
 
 #endif // TWOBLUECUBES_CATCH_LIST_HPP_INCLUDED
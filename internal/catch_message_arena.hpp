@@ -0,0 +1,166 @@
+/*
+ *  catch_message_arena.hpp
+ *  Catch
+ *
+ *  Created by the Catch contributors on 19/10/2026.
+ *  Copyright 2026 the Catch contributors. All rights reserved.
+ *
+ *  Distributed under the Boost Software License, Version 1.0. (See accompanying
+ *  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ *
+ */
+#ifndef TWOBLUECUBES_CATCH_MESSAGE_ARENA_HPP_INCLUDED
+#define TWOBLUECUBES_CATCH_MESSAGE_ARENA_HPP_INCLUDED
+
+#include "catch_common.h"
+#include "catch_resultinfo.hpp"
+#include "catch_interfaces_reporter.h"
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace Catch
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // Storage for strings that are all thrown away together. Storing one just
+    // bumps a position in the current chunk, and reset() rewinds to the first
+    // chunk rather than freeing them - so once the chunks have grown to what a
+    // test case needs, storing strings doesn't allocate at all
+    class MessageArena : NonCopyable
+    {
+        struct Chunk
+        {
+            char* data;
+            std::size_t size;
+        };
+
+    public:
+        ///////////////////////////////////////////////////////////////////////
+        explicit MessageArena
+        (
+            std::size_t chunkSize = 4096
+        )
+        :   m_current( 0 ),
+            m_used( 0 ),
+            m_chunkSize( chunkSize )
+        {
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        ~MessageArena
+        ()
+        {
+            for( std::size_t i = 0; i < m_chunks.size(); ++i )
+                delete[] m_chunks[i].data;
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // Returns a null terminated copy of str, that lasts until reset()
+        const char* store
+        (
+            const std::string& str
+        )
+        {
+            std::size_t size = str.size() + 1;
+            while( m_current < m_chunks.size() && m_chunks[m_current].size - m_used < size )
+            {
+                ++m_current;
+                m_used = 0;
+            }
+            if( m_current == m_chunks.size() )
+            {
+                Chunk chunk;
+                chunk.size = size > m_chunkSize ? size : m_chunkSize;
+                chunk.data = new char[chunk.size];
+                m_chunks.push_back( chunk );
+                m_used = 0;
+            }
+            char* copy = m_chunks[m_current].data + m_used;
+            std::memcpy( copy, str.c_str(), size );
+            m_used += size;
+            return copy;
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        void reset
+        ()
+        {
+            m_current = 0;
+            m_used = 0;
+        }
+
+    private:
+        std::vector<Chunk> m_chunks;
+        std::size_t m_current;
+        std::size_t m_used;
+        std::size_t m_chunkSize;
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    // The INFOs (and other informational results) of a test case, held until
+    // we know whether they are to be reported - i.e. until something fails.
+    // Only the strings are kept, in an arena, so loops that INFO each time
+    // round don't churn the allocator. Full ResultInfos are only rebuilt for
+    // the (rare) records that are actually reported
+    class InfoLog : NonCopyable
+    {
+        struct Record
+        {
+            const char* macroName;
+            const char* filename;
+            std::size_t line;
+            const char* expr;
+            const char* message;
+        };
+
+    public:
+        ///////////////////////////////////////////////////////////////////////
+        void add
+        (
+            const ResultInfo& info
+        )
+        {
+            Record record;
+            record.macroName = m_arena.store( info.getTestMacroName() );
+            record.filename = m_arena.store( info.getFilename() );
+            record.line = info.getLine();
+            record.expr = m_arena.store( info.getExpression() );
+            record.message = m_arena.store( info.getMessage() );
+            m_records.push_back( record );
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        void report
+        (
+            IReporter& reporter
+        )
+        const
+        {
+            std::vector<Record>::const_iterator it = m_records.begin();
+            std::vector<Record>::const_iterator itEnd = m_records.end();
+            for(; it != itEnd; ++it )
+            {
+                ResultInfo info( it->expr, ResultWas::Info, false, it->filename, it->line, it->macroName );
+                info.setMessage( it->message );
+                reporter.Result( info );
+            }
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // Forgets all the records, keeping the memory they used
+        void clear
+        ()
+        {
+            m_records.clear();
+            m_arena.reset();
+        }
+
+    private:
+        std::vector<Record> m_records;
+        MessageArena m_arena;
+    };
+
+} // end namespace Catch
+
+#endif // TWOBLUECUBES_CATCH_MESSAGE_ARENA_HPP_INCLUDED
@@ -0,0 +1,125 @@
+/*
+ *  catch_pairwise.hpp
+ *  Catch
+ *
+ *  Created by the Catch contributors on 19/10/2026.
+ *  Copyright 2026 the Catch contributors. All rights reserved.
+ *
+ *  Distributed under the Boost Software License, Version 1.0. (See accompanying
+ *  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ *
+ */
+#ifndef TWOBLUECUBES_CATCH_PAIRWISE_HPP_INCLUDED
+#define TWOBLUECUBES_CATCH_PAIRWISE_HPP_INCLUDED
+
+#include <vector>
+#include <limits>
+
+namespace Catch
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // Builds a set of rows - one index per parameter in each - such that every
+    // pair of values of every two parameters appears in at least one row.
+    // Uses the greedy "in parameter order" (IPO) strategy: all pairs of the
+    // first two parameters, then each further parameter is added to the
+    // existing rows, picking the value that covers the most new pairs, with
+    // rows added at the end for whatever pairs are left. The first row is
+    // always all zeros
+    inline std::vector<std::vector<std::size_t> > makePairwiseCoveringArray
+    (
+        const std::vector<std::size_t>& sizes
+    )
+    {
+        typedef std::vector<std::size_t> Row;
+        std::vector<Row> rows;
+        if( sizes.empty() )
+            return rows;
+
+        if( sizes.size() == 1 )
+        {
+            for( std::size_t v = 0; v < sizes[0]; ++v )
+                rows.push_back( Row( 1, v ) );
+            return rows;
+        }
+
+        for( std::size_t a = 0; a < sizes[0]; ++a )
+        {
+            for( std::size_t b = 0; b < sizes[1]; ++b )
+            {
+                Row row;
+                row.push_back( a );
+                row.push_back( b );
+                rows.push_back( row );
+            }
+        }
+
+        const std::size_t dontCare = (std::numeric_limits<std::size_t>::max)();
+        for( std::size_t k = 2; k < sizes.size(); ++k )
+        {
+            const std::size_t sizeK = sizes[k];
+
+            // covered[j][vj*sizeK+vk]: whether parameter j having value vj
+            // has been seen alongside parameter k having value vk
+            std::vector<std::vector<bool> > covered( k );
+            for( std::size_t j = 0; j < k; ++j )
+                covered[j].assign( sizes[j] * sizeK, false );
+
+            // Horizontal growth
+            for( std::size_t r = 0; r < rows.size(); ++r )
+            {
+                Row& row = rows[r];
+                std::size_t best = 0;
+                std::size_t bestGain = 0;
+                for( std::size_t v = 0; v < sizeK; ++v )
+                {
+                    std::size_t gain = 0;
+                    for( std::size_t j = 0; j < k; ++j )
+                        if( !covered[j][row[j]*sizeK+v] )
+                            ++gain;
+                    if( gain > bestGain )
+                    {
+                        best = v;
+                        bestGain = gain;
+                    }
+                }
+                row.push_back( best );
+                for( std::size_t j = 0; j < k; ++j )
+                    covered[j][row[j]*sizeK+best] = true;
+            }
+
+            // Vertical growth
+            const std::size_t firstNewRow = rows.size();
+            for( std::size_t j = 0; j < k; ++j )
+            {
+                for( std::size_t vj = 0; vj < sizes[j]; ++vj )
+                {
+                    for( std::size_t vk = 0; vk < sizeK; ++vk )
+                    {
+                        if( covered[j][vj*sizeK+vk] )
+                            continue;
+                        covered[j][vj*sizeK+vk] = true;
+
+                        std::size_t r = firstNewRow;
+                        for(; r < rows.size(); ++r )
+                            if( rows[r][k] == vk && rows[r][j] == dontCare )
+                                break;
+                        if( r == rows.size() )
+                        {
+                            rows.push_back( Row( k+1, dontCare ) );
+                            rows.back()[k] = vk;
+                        }
+                        rows[r][j] = vj;
+                    }
+                }
+            }
+            for( std::size_t r = firstNewRow; r < rows.size(); ++r )
+                for( std::size_t j = 0; j < k; ++j )
+                    if( rows[r][j] == dontCare )
+                        rows[r][j] = 0;
+        }
+        return rows;
+    }
+
+} // end namespace Catch
+
+#endif // TWOBLUECUBES_CATCH_PAIRWISE_HPP_INCLUDED
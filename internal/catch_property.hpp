@@ -0,0 +1,313 @@
+/*
+ *  catch_property.hpp
+ *  Catch
+ *
+ *  Created by the Catch contributors on 19/10/2026.
+ *  Copyright 2026 the Catch contributors. All rights reserved.
+ *
+ *  Distributed under the Boost Software License, Version 1.0. (See accompanying
+ *  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ *
+ */
+#ifndef TWOBLUECUBES_CATCH_PROPERTY_HPP_INCLUDED
+#define TWOBLUECUBES_CATCH_PROPERTY_HPP_INCLUDED
+
+#include "catch_common.h"
+#include "catch_hub.h"
+#include "catch_capture.hpp"
+#include "catch_generators.hpp"
+
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <limits>
+#include <cmath>
+
+namespace Catch
+{
+    // Smaller versions of a value, for narrowing a failing input down to a
+    // minimal one - most promising first. Types without a specialisation
+    // are not shrunk
+    template<typename T,
+             bool IsNumber = std::numeric_limits<T>::is_specialized,
+             bool IsInteger = std::numeric_limits<T>::is_integer>
+    struct Shrinker
+    {
+        static std::vector<T> shrink
+        (
+            const T&
+        )
+        {
+            return std::vector<T>();
+        }
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Zero, then values ever closer to the original (so a boundary is found
+    // by bisection), and the positive value for a negative one
+    template<typename T>
+    struct Shrinker<T, true, true>
+    {
+        static std::vector<T> shrink
+        (
+            const T& value
+        )
+        {
+            std::vector<T> candidates;
+            if( value == 0 )
+                return candidates;
+            candidates.push_back( 0 );
+            // The most negative value has no positive counterpart
+            if( value < 0 && value != std::numeric_limits<T>::min() )
+                candidates.push_back( -value );
+            for( T distance = value / 2; distance != 0; distance /= 2 )
+                candidates.push_back( value - distance );
+            return candidates;
+        }
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    template<>
+    struct Shrinker<bool, true, true>
+    {
+        static std::vector<bool> shrink
+        (
+            bool value
+        )
+        {
+            return value ? std::vector<bool>( 1, false ) : std::vector<bool>();
+        }
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    // As for integers, preferring whole numbers
+    template<typename T>
+    struct Shrinker<T, true, false>
+    {
+        static std::vector<T> shrink
+        (
+            const T& value
+        )
+        {
+            std::vector<T> candidates;
+            if( value == 0 || value != value )
+                return candidates;
+            candidates.push_back( 0 );
+            T whole = value < 0 ? std::ceil( value ) : std::floor( value );
+            if( whole != value )
+                candidates.push_back( whole );
+            T distance = value / 2;
+            for( int i = 0; i < 16; ++i, distance /= 2 )
+                candidates.push_back( value - distance );
+            return candidates;
+        }
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Empty, each half, then with one element left out, then with one element
+    // shrunk
+    template<typename T>
+    struct Shrinker<std::vector<T>, false, false>
+    {
+        static std::vector<std::vector<T> > shrink
+        (
+            const std::vector<T>& value
+        )
+        {
+            std::vector<std::vector<T> > candidates;
+            if( value.empty() )
+                return candidates;
+            candidates.push_back( std::vector<T>() );
+            if( value.size() > 1 )
+            {
+                candidates.push_back( std::vector<T>( value.begin(), value.begin() + value.size()/2 ) );
+                candidates.push_back( std::vector<T>( value.begin() + value.size()/2, value.end() ) );
+            }
+            for( std::size_t i = 0; i < value.size() && value.size() > 1; ++i )
+            {
+                candidates.push_back( value );
+                candidates.back().erase( candidates.back().begin() + i );
+            }
+            for( std::size_t i = 0; i < value.size(); ++i )
+            {
+                std::vector<T> elementCandidates = Shrinker<T>::shrink( value[i] );
+                if( !elementCandidates.empty() )
+                {
+                    candidates.push_back( value );
+                    candidates.back()[i] = elementCandidates[0];
+                }
+            }
+            return candidates;
+        }
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    template<>
+    struct Shrinker<std::string, false, false>
+    {
+        static std::vector<std::string> shrink
+        (
+            const std::string& value
+        )
+        {
+            std::vector<std::string> candidates;
+            if( value.empty() )
+                return candidates;
+            candidates.push_back( "" );
+            if( value.size() > 1 )
+            {
+                candidates.push_back( value.substr( 0, value.size()/2 ) );
+                candidates.push_back( value.substr( value.size()/2 ) );
+                for( std::size_t i = 0; i < value.size(); ++i )
+                    candidates.push_back( value.substr( 0, i ) + value.substr( i+1 ) );
+            }
+            return candidates;
+        }
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    ///////////////////////////////////////////////////////////////////////////
+
+    struct IPropertyTrial
+    {
+        virtual ~IPropertyTrial
+        ()
+        {}
+
+        virtual void run
+            () = 0;
+    };
+
+    // These are defined in catch_property_impl.hpp, with the rest of the
+    // implementation, so they're compiled once rather than in every test file
+    bool runPropertyTrial
+        (   IPropertyTrial& trial
+        );
+
+    void reportPropertyFalsified
+        (   const char* varName,
+            const std::string& value,
+            std::size_t trial,
+            std::size_t trials,
+            std::size_t shrinkSteps,
+            const char* filename,
+            std::size_t line
+        );
+
+    void reportPropertyHeld
+        (   const char* varName,
+            std::size_t trials,
+            const char* filename,
+            std::size_t line
+        );
+
+    ///////////////////////////////////////////////////////////////////////////
+    template<typename T>
+    class PropertyTrial : public IPropertyTrial
+    {
+    public:
+        ///////////////////////////////////////////////////////////////////////////
+        PropertyTrial
+        (
+            void (*property)( T ),
+            const T& value
+        )
+        :   m_property( property ),
+            m_value( value )
+        {
+        }
+
+        ///////////////////////////////////////////////////////////////////////////
+        virtual void run
+        ()
+        {
+            m_property( m_value );
+        }
+
+    private:
+        void (*m_property)( T );
+        const T& m_value;
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Whether the property holds for the value, without reporting anything
+    template<typename T>
+    bool propertyHolds
+    (
+        void (*property)( T ),
+        const T& value
+    )
+    {
+        PropertyTrial<T> trial( property, value );
+        return runPropertyTrial( trial );
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Tries the property with values from the generator. If any fails, it is
+    // shrunk as far as it will go and that is reported as a failure, with the
+    // value and how to reproduce it. The property is then run once more, for
+    // real, with the smallest failing value - so its failures are reported as
+    // usual too (if it fails again - it may not, if it isn't deterministic).
+    // If all pass, that is reported as a single success
+    template<typename T>
+    void checkProperty
+    (
+        const CompositeGenerator<T>& generator,
+        void (*property)( T ),
+        const char* varName,
+        const char* filename,
+        std::size_t line,
+        std::size_t trials = 100
+    )
+    {
+        enum { MaxShrinkSteps = 1000 };
+
+        if( generator.size() == 0 )
+            throw std::logic_error( "PROPERTY was given a generator with no values" );
+        if( generator.size() < trials )
+            trials = generator.size();
+
+        for( std::size_t trial = 0; trial < trials; ++trial )
+        {
+            T value = generator.getValue( trial );
+            if( propertyHolds( property, value ) )
+                continue;
+
+            std::size_t steps = 0;
+            for( bool shrunk = true; shrunk && steps < MaxShrinkSteps; )
+            {
+                shrunk = false;
+                std::vector<T> candidates = Shrinker<T>::shrink( value );
+                for( std::size_t i = 0; i < candidates.size() && !shrunk; ++i )
+                {
+                    T candidate = candidates[i];
+                    if( !propertyHolds( property, candidate ) )
+                    {
+                        value = candidate;
+                        shrunk = true;
+                        ++steps;
+                    }
+                }
+            }
+
+            reportPropertyFalsified( varName, toString( value ), trial, trials, steps, filename, line );
+            property( value );
+            return;
+        }
+
+        reportPropertyHeld( varName, trials, filename, line );
+    }
+
+} // end namespace Catch
+
+///////////////////////////////////////////////////////////////////////////////
+#define INTERNAL_CATCH_PROPERTY( Name, Desc, Type, var, genExpr ) \
+    static void INTERNAL_CATCH_UNIQUE_NAME( catch_internal_Property )( Type var ); \
+    INTERNAL_CATCH_TESTCASE( Name, Desc ) \
+    { \
+        using namespace Catch::Generators; \
+        Catch::checkProperty<Type>( genExpr, &INTERNAL_CATCH_UNIQUE_NAME( catch_internal_Property ), #var, __FILE__, __LINE__ ); \
+    } \
+    static void INTERNAL_CATCH_UNIQUE_NAME( catch_internal_Property )( Type var )
+
+#endif // TWOBLUECUBES_CATCH_PROPERTY_HPP_INCLUDED
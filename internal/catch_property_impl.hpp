@@ -0,0 +1,242 @@
+/*
+ *  catch_property_impl.hpp
+ *  Catch
+ *
+ *  Created by the Catch contributors on 19/10/2026.
+ *  Copyright 2026 the Catch contributors. All rights reserved.
+ *
+ *  Distributed under the Boost Software License, Version 1.0. (See accompanying
+ *  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ *
+ */
+#ifndef TWOBLUECUBES_CATCH_PROPERTY_IMPL_HPP_INCLUDED
+#define TWOBLUECUBES_CATCH_PROPERTY_IMPL_HPP_INCLUDED
+
+#include "catch_property.hpp"
+#include "catch_hub.h"
+#include "catch_interfaces_capture.h"
+
+#include <sstream>
+
+namespace Catch
+{
+    // Stands in for the runner while a property is tried out, so trials (and
+    // attempts at shrinking) just note whether they failed, without reporting
+    // anything
+    class PropertyTrialCapture : public IResultCapture
+    {
+    public:
+        ///////////////////////////////////////////////////////////////////////////
+        explicit PropertyTrialCapture
+        (
+            IResultCapture& parent
+        )
+        :   m_parent( parent ),
+            m_failed( false )
+        {
+        }
+
+        ///////////////////////////////////////////////////////////////////////////
+        bool failed
+        ()
+        const
+        {
+            return m_failed;
+        }
+
+        ///////////////////////////////////////////////////////////////////////////
+        void setFailed
+        ()
+        {
+            m_failed = true;
+        }
+
+    private: // IResultCapture
+
+        ///////////////////////////////////////////////////////////////////////////
+        virtual void testEnded
+        (
+            const ResultInfo& result
+        )
+        {
+            if( !result.ok() )
+                m_failed = true;
+        }
+
+        ///////////////////////////////////////////////////////////////////////////
+        virtual bool sectionStarted
+        (
+            const std::string&,
+            const std::string&,
+            std::size_t&,
+            std::size_t&
+        )
+        {
+            return true;
+        }
+
+        ///////////////////////////////////////////////////////////////////////////
+        virtual void sectionEnded
+        (
+            const std::string&,
+            std::size_t,
+            std::size_t
+        )
+        {
+        }
+
+        ///////////////////////////////////////////////////////////////////////////
+        virtual void pushScopedInfo
+        (
+            ScopedInfo*
+        )
+        {
+        }
+
+        ///////////////////////////////////////////////////////////////////////////
+        virtual void popScopedInfo
+        (
+            ScopedInfo*
+        )
+        {
+        }
+
+        ///////////////////////////////////////////////////////////////////////////
+        virtual bool shouldDebugBreak
+        ()
+        const
+        {
+            return false;
+        }
+
+        ///////////////////////////////////////////////////////////////////////////
+        virtual ResultAction::Value acceptResult
+        (
+            bool result
+        )
+        {
+            return acceptResult( result ? ResultWas::Ok : ResultWas::ExpressionFailed );
+        }
+
+        ///////////////////////////////////////////////////////////////////////////
+        virtual ResultAction::Value acceptResult
+        (
+            ResultWas::OfType result
+        )
+        {
+            m_currentResult.setResultType( result );
+            testEnded( m_currentResult );
+            bool ok = m_currentResult.ok();
+            m_currentResult = ResultInfo();
+            return ok ? ResultAction::None : ResultAction::Failed;
+        }
+
+        ///////////////////////////////////////////////////////////////////////////
+        virtual const ResultInfo& getCurrentResult
+        ()
+        const
+        {
+            return m_currentResult;
+        }
+
+        ///////////////////////////////////////////////////////////////////////////
+        virtual void acceptExpression
+        (
+            const ResultInfo& resultInfo
+        )
+        {
+            m_currentResult = resultInfo;
+        }
+
+        ///////////////////////////////////////////////////////////////////////////
+        virtual void acceptMessage
+        (
+            const std::string& msg
+        )
+        {
+            m_currentResult.setMessage( msg );
+        }
+
+        ///////////////////////////////////////////////////////////////////////////
+        virtual std::string getCurrentTestName
+        ()
+        const
+        {
+            return m_parent.getCurrentTestName();
+        }
+
+    private:
+        IResultCapture& m_parent;
+        ResultInfo m_currentResult;
+        bool m_failed;
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    bool runPropertyTrial
+    (
+        IPropertyTrial& trial
+    )
+    {
+        PropertyTrialCapture capture( Hub::getResultCapture() );
+        HubContext hubContext( &Hub::getRunner(), &capture );
+        hubContext.setRngSeed( Hub::getRngSeed() );
+        hubContext.setFpTolerance( Hub::getFpTolerance() );
+        HubContext* prevHubContext = Hub::enterContext( &hubContext );
+        try
+        {
+            trial.run();
+        }
+        catch( TestFailureException& )
+        {
+            // A REQUIRE failed - already noted
+        }
+        catch(...)
+        {
+            capture.setFailed();
+        }
+        Hub::leaveContext( &hubContext, prevHubContext );
+        return !capture.failed();
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    void reportPropertyFalsified
+    (
+        const char* varName,
+        const std::string& value,
+        std::size_t trial,
+        std::size_t trials,
+        std::size_t shrinkSteps,
+        const char* filename,
+        std::size_t line
+    )
+    {
+        std::ostringstream oss;
+        oss << "Falsified by trial " << ( trial+1 ) << " of " << trials
+            << " (rng seed " << Hub::getRngSeed() << "), shrunk in " << shrinkSteps << " step(s) to: "
+            << varName << " = " << value;
+        IResultCapture& resultCapture = Hub::getResultCapture();
+        resultCapture.acceptExpression( ResultInfo( "", ResultWas::Unknown, false, filename, line, "PROPERTY" ) );
+        resultCapture.acceptMessage( oss.str() );
+        resultCapture.acceptResult( ResultWas::ExplicitFailure );
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    void reportPropertyHeld
+    (
+        const char* varName,
+        std::size_t trials,
+        const char* filename,
+        std::size_t line
+    )
+    {
+        std::ostringstream oss;
+        oss << "Held for " << trials << " trial(s)";
+        IResultCapture& resultCapture = Hub::getResultCapture();
+        resultCapture.acceptExpression( ResultInfo( varName, ResultWas::Unknown, false, filename, line, "PROPERTY" ) );
+        resultCapture.acceptMessage( oss.str() );
+        resultCapture.acceptResult( ResultWas::Ok );
+    }
+
+} // end namespace Catch
+
+#endif // TWOBLUECUBES_CATCH_PROPERTY_IMPL_HPP_INCLUDED
@@ -0,0 +1,103 @@
+/*
+ *  catch_random.hpp
+ *  Catch
+ *
+ *  Created by the Catch contributors on 19/10/2026.
+ *  Copyright 2026 the Catch contributors. All rights reserved.
+ *
+ *  Distributed under the Boost Software License, Version 1.0. (See accompanying
+ *  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ *
+ */
+#ifndef TWOBLUECUBES_CATCH_RANDOM_HPP_INCLUDED
+#define TWOBLUECUBES_CATCH_RANDOM_HPP_INCLUDED
+
+#include <vector>
+
+namespace Catch
+{
+    // xorshift64*. Small and fast, and - unlike rand() or std::random_shuffle -
+    // gives the same sequence for a given seed on every platform, so a run
+    // can be reproduced from its seed
+    class RandomNumberGenerator
+    {
+    public:
+        ///////////////////////////////////////////////////////////////////////////
+        explicit RandomNumberGenerator
+        (
+            unsigned long long seed
+        )
+        :   m_state( mix( seed ) )
+        {
+            // The all-zero state is a fixed point
+            if( m_state == 0 )
+                m_state = 0x9E3779B97F4A7C15ULL;
+        }
+
+        ///////////////////////////////////////////////////////////////////////////
+        unsigned long long next
+        ()
+        {
+            m_state ^= m_state >> 12;
+            m_state ^= m_state << 25;
+            m_state ^= m_state >> 27;
+            return m_state * 2685821657736338717ULL;
+        }
+
+        ///////////////////////////////////////////////////////////////////////////
+        // Uniformly distributed in [0, bound)
+        unsigned long long nextBelow
+        (
+            unsigned long long bound
+        )
+        {
+            // Reject the top, partial, range so every value is equally likely
+            unsigned long long limit = ~0ULL - ~0ULL % bound;
+            unsigned long long value;
+            do
+            {
+                value = next();
+            }
+            while( value >= limit );
+            return value % bound;
+        }
+
+        ///////////////////////////////////////////////////////////////////////////
+        // Spreads the bits of nearby seeds (1, 2, 3...) across the whole state
+        static unsigned long long mix
+        (
+            unsigned long long value
+        )
+        {
+            value += 0x9E3779B97F4A7C15ULL;
+            value = ( value ^ ( value >> 30 ) ) * 0xBF58476D1CE4E5B9ULL;
+            value = ( value ^ ( value >> 27 ) ) * 0x94D049BB133111EBULL;
+            return value ^ ( value >> 31 );
+        }
+
+    private:
+        unsigned long long m_state;
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Fisher-Yates
+    template<typename T>
+    void shuffle
+    (
+        std::vector<T>& items,
+        RandomNumberGenerator& rng
+    )
+    {
+        for( std::size_t i = items.size(); i > 1; --i )
+        {
+            // Swapped by hand, as std::swap would need <algorithm> in every test file
+            std::size_t j = static_cast<std::size_t>( rng.nextBelow( i ) );
+            T item = items[i-1];
+            items[i-1] = items[j];
+            items[j] = item;
+        }
+    }
+
+} // end namespace Catch
+
+#endif // TWOBLUECUBES_CATCH_RANDOM_HPP_INCLUDED
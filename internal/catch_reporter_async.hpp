@@ -0,0 +1,366 @@
+/*
+ *  catch_reporter_async.hpp
+ *  Catch
+ *
+ *  Created by the Catch contributors on 19/10/2026.
+ *  Copyright 2026 the Catch contributors. All rights reserved.
+ *
+ *  Distributed under the Boost Software License, Version 1.0. (See accompanying
+ *  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ *
+ */
+#ifndef TWOBLUECUBES_CATCH_REPORTER_ASYNC_HPP_INCLUDED
+#define TWOBLUECUBES_CATCH_REPORTER_ASYNC_HPP_INCLUDED
+
+#include "catch_interfaces_reporter.h"
+#include "catch_test_case_info.hpp"
+#include "catch_resultinfo.hpp"
+#include "catch_thread.hpp"
+
+#include <memory>
+#include <vector>
+#include <deque>
+#include <cassert>
+
+namespace Catch
+{
+    // Queues events from the test thread and hands them to the real reporter
+    // on a background thread, so slow output doesn't hold up the tests.
+    // The queue is bounded: once full, the test thread waits for it to drain.
+    // Events must come from one thread at a time, as for any reporter: the
+    // Runner reports from the test thread, and from any other thread (worker
+    // threads' assertions, the timeout watchdog) only while holding its mutex
+    class AsyncReporter : public IReporter, private IRunnable
+    {
+        struct Event
+        {
+            enum Type
+            {
+                StartTesting,
+                EndTesting,
+                StartGroup,
+                EndGroup,
+                StartSection,
+                EndSection,
+                StartTestCase,
+                EndTestCase,
+                Result
+            };
+
+            Type m_type;
+            std::string m_name;
+            std::string m_description;
+            std::size_t m_succeeded;
+            std::size_t m_failed;
+            std::string m_stdOut;
+            std::string m_stdErr;
+            ResultInfo m_result;
+        };
+
+    public:
+        ///////////////////////////////////////////////////////////////////////////
+        AsyncReporter
+        (
+            IReporter* reporter,
+            std::size_t maxQueuedEvents = 1024
+        )
+        :   m_reporter( reporter ),
+            m_queue( maxQueuedEvents > 0 ? maxQueuedEvents : 1 ),
+            m_head( 0 ),
+            m_size( 0 ),
+            m_busy( false ),
+            m_stopping( false ),
+            m_reserved( false ),
+            m_thread( *this )
+        {
+        }
+
+        ///////////////////////////////////////////////////////////////////////////
+        ~AsyncReporter
+        ()
+        {
+            flush();
+            {
+                ScopedLock lock( m_mutex );
+                m_stopping = true;
+                m_notEmpty.signal();
+            }
+            m_thread.join();
+        }
+
+        ///////////////////////////////////////////////////////////////////////////
+        // Blocks until every queued event has been handed to the real reporter
+        void flush
+        ()
+        {
+            if( !m_thread.isRunning() )
+                return;
+            ScopedLock lock( m_mutex );
+            while( m_size > 0 || m_busy )
+                m_drained.wait( m_mutex );
+        }
+
+    private: // IReporter
+
+        ///////////////////////////////////////////////////////////////////////////
+        virtual void StartTesting
+        ()
+        {
+            enqueue( Event::StartTesting );
+        }
+
+        ///////////////////////////////////////////////////////////////////////////
+        virtual void EndTesting
+        (
+            std::size_t succeeded,
+            std::size_t failed
+        )
+        {
+            Event& event = enqueue( Event::EndTesting, false );
+            event.m_succeeded = succeeded;
+            event.m_failed = failed;
+            commit();
+            flush();
+        }
+
+        ///////////////////////////////////////////////////////////////////////////
+        virtual void StartGroup
+        (
+            const std::string& groupName
+        )
+        {
+            enqueue( Event::StartGroup, false ).m_name = groupName;
+            commit();
+        }
+
+        ///////////////////////////////////////////////////////////////////////////
+        virtual void EndGroup
+        (
+            const std::string& groupName,
+            std::size_t succeeded,
+            std::size_t failed
+        )
+        {
+            Event& event = enqueue( Event::EndGroup, false );
+            event.m_name = groupName;
+            event.m_succeeded = succeeded;
+            event.m_failed = failed;
+            commit();
+        }
+
+        ///////////////////////////////////////////////////////////////////////////
+        virtual void StartSection
+        (
+            const std::string& sectionName,
+            const std::string description
+        )
+        {
+            Event& event = enqueue( Event::StartSection, false );
+            event.m_name = sectionName;
+            event.m_description = description;
+            commit();
+        }
+
+        ///////////////////////////////////////////////////////////////////////////
+        virtual void EndSection
+        (
+            const std::string& sectionName,
+            std::size_t succeeded,
+            std::size_t failed
+        )
+        {
+            Event& event = enqueue( Event::EndSection, false );
+            event.m_name = sectionName;
+            event.m_succeeded = succeeded;
+            event.m_failed = failed;
+            commit();
+        }
+
+        ///////////////////////////////////////////////////////////////////////////
+        virtual void StartTestCase
+        (
+            const TestCaseInfo& testInfo
+        )
+        {
+            // The caller's TestCaseInfo may be gone by the time the background
+            // thread gets to it, so hold on to a copy
+            {
+                ScopedLock lock( m_mutex );
+                m_testCases.push_back( testInfo );
+            }
+            enqueue( Event::StartTestCase );
+        }
+
+        ///////////////////////////////////////////////////////////////////////////
+        virtual void EndTestCase
+        (
+            const TestCaseInfo& /*testInfo*/,
+            std::size_t succeeded,
+            std::size_t failed,
+            const std::string& stdOut,
+            const std::string& stdErr
+        )
+        {
+            Event& event = enqueue( Event::EndTestCase, false );
+            event.m_succeeded = succeeded;
+            event.m_failed = failed;
+            event.m_stdOut = stdOut;
+            event.m_stdErr = stdErr;
+            commit();
+        }
+
+        ///////////////////////////////////////////////////////////////////////////
+        virtual void Result
+        (
+            const ResultInfo& result
+        )
+        {
+            enqueue( Event::Result, false ).m_result = result;
+            commit();
+        }
+
+    private: // IRunnable
+
+        ///////////////////////////////////////////////////////////////////////////
+        virtual void run
+        ()
+        {
+            Event event;
+            for(;;)
+            {
+                {
+                    ScopedLock lock( m_mutex );
+                    while( m_size == 0 && !m_stopping )
+                        m_notEmpty.wait( m_mutex );
+                    if( m_size == 0 )
+                        return;
+                    std::swap( event, m_queue[m_head] );
+                    m_head = ( m_head + 1 ) % m_queue.size();
+                    m_size--;
+                    m_busy = true;
+                    m_notFull.signal();
+                }
+
+                dispatch( event );
+
+                {
+                    ScopedLock lock( m_mutex );
+                    m_busy = false;
+                    if( m_size == 0 )
+                        m_drained.broadcast();
+                }
+            }
+        }
+
+    private:
+
+        ///////////////////////////////////////////////////////////////////////////
+        // Reserves the next slot in the queue, waiting for space if necessary.
+        // Unless committed immediately the caller fills it in, then calls commit().
+        // The slot is only ours until then because events come from one thread
+        // at a time (see above) - which is asserted, as a second producer would
+        // be handed the same slot
+        Event& enqueue
+        (
+            Event::Type type,
+            bool commitNow = true
+        )
+        {
+            ScopedLock lock( m_mutex );
+            assert( !m_reserved && "AsyncReporter: events reported from two threads at once" );
+            while( m_size == m_queue.size() )
+                m_notFull.wait( m_mutex );
+            Event& event = m_queue[( m_head + m_size ) % m_queue.size()];
+            event.m_type = type;
+            if( commitNow )
+            {
+                m_size++;
+                m_notEmpty.signal();
+            }
+            else
+            {
+                m_reserved = true;
+            }
+            return event;
+        }
+
+        ///////////////////////////////////////////////////////////////////////////
+        void commit
+        ()
+        {
+            ScopedLock lock( m_mutex );
+            assert( m_reserved );
+            m_reserved = false;
+            m_size++;
+            m_notEmpty.signal();
+        }
+
+        ///////////////////////////////////////////////////////////////////////////
+        void dispatch
+        (
+            const Event& event
+        )
+        {
+            switch( event.m_type )
+            {
+                case Event::StartTesting:
+                    m_reporter->StartTesting();
+                    break;
+                case Event::EndTesting:
+                    m_reporter->EndTesting( event.m_succeeded, event.m_failed );
+                    break;
+                case Event::StartGroup:
+                    m_reporter->StartGroup( event.m_name );
+                    break;
+                case Event::EndGroup:
+                    m_reporter->EndGroup( event.m_name, event.m_succeeded, event.m_failed );
+                    break;
+                case Event::StartSection:
+                    m_reporter->StartSection( event.m_name, event.m_description );
+                    break;
+                case Event::EndSection:
+                    m_reporter->EndSection( event.m_name, event.m_succeeded, event.m_failed );
+                    break;
+                case Event::StartTestCase:
+                    m_reporter->StartTestCase( currentTestCase() );
+                    break;
+                case Event::EndTestCase:
+                    m_reporter->EndTestCase( currentTestCase(), event.m_succeeded, event.m_failed, event.m_stdOut, event.m_stdErr );
+                    {
+                        ScopedLock lock( m_mutex );
+                        m_testCases.pop_front();
+                    }
+                    break;
+                case Event::Result:
+                    m_reporter->Result( event.m_result );
+                    break;
+            }
+        }
+
+        ///////////////////////////////////////////////////////////////////////////
+        const TestCaseInfo& currentTestCase
+        ()
+        {
+            ScopedLock lock( m_mutex );
+            return m_testCases.front();
+        }
+
+        std::auto_ptr<IReporter> m_reporter;
+        std::vector<Event> m_queue;
+        std::size_t m_head;
+        std::size_t m_size;
+        bool m_busy;
+        bool m_stopping;
+        bool m_reserved;
+        std::deque<TestCaseInfo> m_testCases;
+
+        Mutex m_mutex;
+        Condition m_notEmpty;
+        Condition m_notFull;
+        Condition m_drained;
+        Thread m_thread;
+    };
+
+} // end namespace Catch
+
+#endif // TWOBLUECUBES_CATCH_REPORTER_ASYNC_HPP_INCLUDED
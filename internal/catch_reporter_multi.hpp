@@ -0,0 +1,272 @@
+/*
+ *  catch_reporter_multi.hpp
+ *  Catch
+ *
+ *  Created by the Catch contributors on 19/10/2026.
+ *  Copyright 2026 the Catch contributors. All rights reserved.
+ *
+ *  Distributed under the Boost Software License, Version 1.0. (See accompanying
+ *  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ *
+ */
+#ifndef TWOBLUECUBES_CATCH_REPORTER_MULTI_HPP_INCLUDED
+#define TWOBLUECUBES_CATCH_REPORTER_MULTI_HPP_INCLUDED
+
+#include "catch_interfaces_reporter.h"
+#include "catch_hub.h"
+
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+namespace Catch
+{
+    // The destination of an additional reporter. Defaults to stdout and
+    // takes everything else from the main config
+    class ReporterOutput : public IReporterConfig
+    {
+    public:
+        ///////////////////////////////////////////////////////////////////////////
+        ReporterOutput
+        (
+            const IReporterConfig& parent,
+            bool binary
+        )
+        :   m_parent( parent ),
+            m_binary( binary ),
+            m_streambuf( NULL ),
+            m_os( std::cout.rdbuf() )
+        {
+        }
+
+        ///////////////////////////////////////////////////////////////////////////
+        ~ReporterOutput
+        ()
+        {
+            m_os.flush();
+            setStreamBuf( NULL );
+        }
+
+        ///////////////////////////////////////////////////////////////////////////
+        bool setFilename
+        (
+            const std::string& filename
+        )
+        {
+            setStreamBuf( NULL );
+            m_ofs.open( filename.c_str(), m_binary ? std::ios::out | std::ios::binary : std::ios::out );
+            if( m_ofs.fail() )
+                return false;
+            m_os.rdbuf( m_ofs.rdbuf() );
+            return true;
+        }
+
+        ///////////////////////////////////////////////////////////////////////////
+        void useStream
+        (
+            const std::string& streamName
+        )
+        {
+            setStreamBuf( Hub::createStreamBuf( streamName ) );
+        }
+
+        ///////////////////////////////////////////////////////////////////////////
+        virtual std::ostream& stream
+        ()
+        const
+        {
+            return m_os;
+        }
+
+        ///////////////////////////////////////////////////////////////////////////
+        virtual bool includeSuccessfulResults
+        ()
+        const
+        {
+            return m_parent.includeSuccessfulResults();
+        }
+
+        ///////////////////////////////////////////////////////////////////////////
+        virtual unsigned int rngSeed
+        ()
+        const
+        {
+            return m_parent.rngSeed();
+        }
+
+    private:
+        ///////////////////////////////////////////////////////////////////////////
+        void setStreamBuf
+        (
+            std::streambuf* buf
+        )
+        {
+            // Delete previous stream buf if we own it
+            if( m_streambuf && dynamic_cast<StreamBufBase*>( m_streambuf ) )
+                delete m_streambuf;
+
+            m_streambuf = buf;
+            m_os.rdbuf( buf ? buf : std::cout.rdbuf() );
+        }
+
+        const IReporterConfig& m_parent;
+        bool m_binary;
+        std::ofstream m_ofs;
+        std::streambuf* m_streambuf;
+        mutable std::ostream m_os;
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    ///////////////////////////////////////////////////////////////////////////
+
+    // Forwards every event to each of a number of reporters, so several
+    // formats can be produced from a single run
+    class MultiReporter : public IReporter
+    {
+    public:
+        ///////////////////////////////////////////////////////////////////////////
+        ~MultiReporter
+        ()
+        {
+            // Reporters may still write to their outputs as they go
+            deleteAll( m_reporters );
+            deleteAll( m_outputs );
+        }
+
+        ///////////////////////////////////////////////////////////////////////////
+        // Takes ownership of both the reporter and its output (if any)
+        void add
+        (
+            IReporter* reporter,
+            ReporterOutput* output = NULL
+        )
+        {
+            m_reporters.push_back( reporter );
+            if( output )
+                m_outputs.push_back( output );
+        }
+
+        ///////////////////////////////////////////////////////////////////////////
+        ReporterOutput* getLastOutput
+        ()
+        {
+            return m_outputs.empty() ? NULL : m_outputs.back();
+        }
+
+        ///////////////////////////////////////////////////////////////////////////
+        void flushOutputs
+        ()
+        const
+        {
+            for( std::size_t i = 0; i < m_outputs.size(); ++i )
+                m_outputs[i]->stream().flush();
+        }
+
+    private: // IReporter
+
+        ///////////////////////////////////////////////////////////////////////////
+        virtual void StartTesting
+        ()
+        {
+            for( std::size_t i = 0; i < m_reporters.size(); ++i )
+                m_reporters[i]->StartTesting();
+        }
+
+        ///////////////////////////////////////////////////////////////////////////
+        virtual void EndTesting
+        (
+            std::size_t succeeded,
+            std::size_t failed
+        )
+        {
+            for( std::size_t i = 0; i < m_reporters.size(); ++i )
+                m_reporters[i]->EndTesting( succeeded, failed );
+        }
+
+        ///////////////////////////////////////////////////////////////////////////
+        virtual void StartGroup
+        (
+            const std::string& groupName
+        )
+        {
+            for( std::size_t i = 0; i < m_reporters.size(); ++i )
+                m_reporters[i]->StartGroup( groupName );
+        }
+
+        ///////////////////////////////////////////////////////////////////////////
+        virtual void EndGroup
+        (
+            const std::string& groupName,
+            std::size_t succeeded,
+            std::size_t failed
+        )
+        {
+            for( std::size_t i = 0; i < m_reporters.size(); ++i )
+                m_reporters[i]->EndGroup( groupName, succeeded, failed );
+        }
+
+        ///////////////////////////////////////////////////////////////////////////
+        virtual void StartSection
+        (
+            const std::string& sectionName,
+            const std::string description
+        )
+        {
+            for( std::size_t i = 0; i < m_reporters.size(); ++i )
+                m_reporters[i]->StartSection( sectionName, description );
+        }
+
+        ///////////////////////////////////////////////////////////////////////////
+        virtual void EndSection
+        (
+            const std::string& sectionName,
+            std::size_t succeeded,
+            std::size_t failed
+        )
+        {
+            for( std::size_t i = 0; i < m_reporters.size(); ++i )
+                m_reporters[i]->EndSection( sectionName, succeeded, failed );
+        }
+
+        ///////////////////////////////////////////////////////////////////////////
+        virtual void StartTestCase
+        (
+            const TestCaseInfo& testInfo
+        )
+        {
+            for( std::size_t i = 0; i < m_reporters.size(); ++i )
+                m_reporters[i]->StartTestCase( testInfo );
+        }
+
+        ///////////////////////////////////////////////////////////////////////////
+        virtual void EndTestCase
+        (
+            const TestCaseInfo& testInfo,
+            std::size_t succeeded,
+            std::size_t failed,
+            const std::string& stdOut,
+            const std::string& stdErr
+        )
+        {
+            for( std::size_t i = 0; i < m_reporters.size(); ++i )
+                m_reporters[i]->EndTestCase( testInfo, succeeded, failed, stdOut, stdErr );
+        }
+
+        ///////////////////////////////////////////////////////////////////////////
+        virtual void Result
+        (
+            const ResultInfo& result
+        )
+        {
+            for( std::size_t i = 0; i < m_reporters.size(); ++i )
+                m_reporters[i]->Result( result );
+        }
+
+    private:
+        std::vector<IReporter*> m_reporters;
+        std::vector<ReporterOutput*> m_outputs;
+    };
+
+} // end namespace Catch
+
+#endif // TWOBLUECUBES_CATCH_REPORTER_MULTI_HPP_INCLUDED
@@ -13,6 +13,7 @@
 #define TWOBLUECUBES_CATCH_REPORTER_REGISTRARS_HPP_INCLUDED
 
 #include "catch_hub.h"
+#include "catch_interfaces_reporter.h"
 
 namespace Catch
 {    
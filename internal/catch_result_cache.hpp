@@ -0,0 +1,175 @@
+/*
+ *  catch_result_cache.hpp
+ *  Catch
+ *
+ *  Created by the Catch contributors on 19/10/2026.
+ *  Copyright 2026 the Catch contributors. All rights reserved.
+ *
+ *  Distributed under the Boost Software License, Version 1.0. (See accompanying
+ *  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ *
+ */
+#ifndef TWOBLUECUBES_CATCH_RESULT_CACHE_HPP_INCLUDED
+#define TWOBLUECUBES_CATCH_RESULT_CACHE_HPP_INCLUDED
+
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <cstdio>
+
+#ifdef _WIN32
+    #include <direct.h>
+#else
+    #include <sys/stat.h>
+    #include <sys/types.h>
+#endif
+
+namespace Catch
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // 64 bit FNV-1a. Not cryptographic - just good enough to tell builds apart
+    inline unsigned long long hashBytes
+    (
+        const char* data,
+        std::size_t size,
+        unsigned long long hash = 14695981039346656037ULL
+    )
+    {
+        for( std::size_t i = 0; i < size; ++i )
+        {
+            hash ^= static_cast<unsigned char>( data[i] );
+            hash *= 1099511628211ULL;
+        }
+        return hash;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    inline unsigned long long hashString
+    (
+        const std::string& str,
+        unsigned long long hash = 14695981039346656037ULL
+    )
+    {
+        // Include the terminator so "ab"+"c" and "a"+"bc" differ
+        return hashBytes( str.c_str(), str.size()+1, hash );
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Returns false if the file could not be read
+    inline bool hashFile
+    (
+        const std::string& filename,
+        unsigned long long& hash
+    )
+    {
+        std::ifstream ifs( filename.c_str(), std::ios::in | std::ios::binary );
+        if( ifs.fail() )
+            return false;
+
+        hash = 14695981039346656037ULL;
+        char buffer[65536];
+        while( ifs.read( buffer, sizeof( buffer ) ) || ifs.gcount() > 0 )
+            hash = hashBytes( buffer, static_cast<std::size_t>( ifs.gcount() ), hash );
+        return !ifs.bad();
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    inline std::string toHex
+    (
+        unsigned long long value
+    )
+    {
+        std::ostringstream oss;
+        oss.width( 16 );
+        oss.fill( '0' );
+        oss << std::hex << value;
+        return oss.str();
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    ///////////////////////////////////////////////////////////////////////////
+
+    // Remembers which test cases passed, keyed on a fingerprint of the build
+    // and the options that could change the outcome. One small file per
+    // passing test case is kept in the cache directory
+    class ResultCache
+    {
+    public:
+        ///////////////////////////////////////////////////////////////////////////
+        ResultCache
+        (
+            const std::string& directory,
+            const std::string& fingerprint
+        )
+        :   m_directory( directory ),
+            m_baseHash( hashString( fingerprint ) )
+        {
+            if( !m_directory.empty() && m_directory[m_directory.size()-1] != '/' && m_directory[m_directory.size()-1] != '\\' )
+                m_directory += '/';
+#ifdef _WIN32
+            _mkdir( directory.c_str() );
+#else
+            mkdir( directory.c_str(), 0777 );
+#endif
+        }
+
+        ///////////////////////////////////////////////////////////////////////////
+        // Returns true, with the number of assertions that passed, if the test
+        // case is known to have passed with the same build and options
+        bool lookup
+        (
+            const std::string& testName,
+            std::size_t& successes
+        )
+        const
+        {
+            std::ifstream ifs( entryFilename( testName ).c_str() );
+            std::string outcome;
+            std::string name;
+            if( !( ifs >> outcome >> successes ) || outcome != "passed" )
+                return false;
+            // Guard against the (unlikely) case of two names hashing the same
+            std::getline( ifs >> std::ws, name );
+            return name == testName;
+        }
+
+        ///////////////////////////////////////////////////////////////////////////
+        void store
+        (
+            const std::string& testName,
+            std::size_t successes
+        )
+        const
+        {
+            std::ofstream ofs( entryFilename( testName ).c_str() );
+            ofs << "passed " << successes << " " << testName << "\n";
+        }
+
+        ///////////////////////////////////////////////////////////////////////////
+        void remove
+        (
+            const std::string& testName
+        )
+        const
+        {
+            std::remove( entryFilename( testName ).c_str() );
+        }
+
+    private:
+        ///////////////////////////////////////////////////////////////////////////
+        std::string entryFilename
+        (
+            const std::string& testName
+        )
+        const
+        {
+            return m_directory + toHex( hashString( testName, m_baseHash ) );
+        }
+
+        std::string m_directory;
+        unsigned long long m_baseHash;
+    };
+
+} // end namespace Catch
+
+#endif // TWOBLUECUBES_CATCH_RESULT_CACHE_HPP_INCLUDED
@@ -41,7 +41,8 @@ struct ResultWas{ enum OfType
         {
             None,
             Failed = 1,     // Failure - but no debug break if Debug bit not set
-            DebugFailed = 3 // Indicates that the debugger should break, if possible
+            DebugFailed = 3, // Indicates that the debugger should break, if possible
+            FailedOnWorkerThread = 5 // Failure - but on a thread other than the test's, so the test can't be aborted
         };    
     };
     
@@ -83,7 +83,7 @@ namespace Catch
         }
 
         ///////////////////////////////////////////////////////////////////////////
-        std::string getExpression
+        const std::string& getExpression
         ()
         const
         {
@@ -102,7 +102,7 @@ namespace Catch
         }
         
         ///////////////////////////////////////////////////////////////////////////
-        std::string getMessage
+        const std::string& getMessage
         ()
         const
         {
@@ -110,7 +110,7 @@ namespace Catch
         }
         
         ///////////////////////////////////////////////////////////////////////////
-        std::string getFilename
+        const std::string& getFilename
         ()
         const
         {
@@ -126,7 +126,7 @@ namespace Catch
         }
         
         ///////////////////////////////////////////////////////////////////////////
-        std::string getTestMacroName
+        const std::string& getTestMacroName
         ()
         const
         {
@@ -0,0 +1,144 @@
+/*
+ *  catch_run_state.hpp
+ *  Catch
+ *
+ *  Created by the Catch contributors on 19/10/2026.
+ *  Copyright 2026 the Catch contributors. All rights reserved.
+ *
+ *  Distributed under the Boost Software License, Version 1.0. (See accompanying
+ *  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ *
+ */
+#ifndef TWOBLUECUBES_CATCH_RUN_STATE_HPP_INCLUDED
+#define TWOBLUECUBES_CATCH_RUN_STATE_HPP_INCLUDED
+
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <map>
+
+namespace Catch
+{
+    // The outcome of each test case the last time it was run, kept in a file
+    // between runs. One line per test case:
+    //
+    //     <passed|failed> <duration in milliseconds> <test name>
+    //
+    // Results from a run are merged into what was there before, so test cases
+    // that weren't run this time keep their previous outcome
+    class RunState
+    {
+        struct Record
+        {
+            Record
+            ()
+            :   m_passed( false ),
+                m_durationMs( 0 )
+            {}
+
+            bool m_passed;
+            unsigned long long m_durationMs;
+        };
+
+    public:
+        ///////////////////////////////////////////////////////////////////////////
+        // Returns false if the file could not be read. Malformed lines are skipped
+        bool load
+        (
+            const std::string& filename
+        )
+        {
+            std::ifstream ifs( filename.c_str() );
+            if( ifs.fail() )
+                return false;
+
+            std::string line;
+            while( std::getline( ifs, line ) )
+            {
+                std::istringstream iss( line );
+                std::string outcome;
+                Record record;
+                if( !( iss >> outcome >> record.m_durationMs ) )
+                    continue;
+                if( outcome != "passed" && outcome != "failed" )
+                    continue;
+                record.m_passed = outcome == "passed";
+
+                std::string name;
+                std::getline( iss >> std::ws, name );
+                if( !name.empty() )
+                    m_records[name] = record;
+            }
+            return true;
+        }
+
+        ///////////////////////////////////////////////////////////////////////////
+        bool save
+        (
+            const std::string& filename
+        )
+        const
+        {
+            std::ofstream ofs( filename.c_str() );
+            if( ofs.fail() )
+                return false;
+
+            std::map<std::string, Record>::const_iterator it = m_records.begin();
+            std::map<std::string, Record>::const_iterator itEnd = m_records.end();
+            for(; it != itEnd; ++it )
+                ofs << ( it->second.m_passed ? "passed " : "failed " ) << it->second.m_durationMs << " " << it->first << "\n";
+            ofs.flush();
+            return !ofs.fail();
+        }
+
+        ///////////////////////////////////////////////////////////////////////////
+        void record
+        (
+            const std::string& testName,
+            bool passed,
+            unsigned long long durationMs
+        )
+        {
+            Record& record = m_records[testName];
+            record.m_passed = passed;
+            record.m_durationMs = durationMs;
+        }
+
+        ///////////////////////////////////////////////////////////////////////////
+        std::vector<std::string> getFailedTestNames
+        ()
+        const
+        {
+            std::vector<std::string> names;
+            std::map<std::string, Record>::const_iterator it = m_records.begin();
+            std::map<std::string, Record>::const_iterator itEnd = m_records.end();
+            for(; it != itEnd; ++it )
+                if( !it->second.m_passed )
+                    names.push_back( it->first );
+            return names;
+        }
+
+        ///////////////////////////////////////////////////////////////////////////
+        // Returns false if there is no record of the test
+        bool getDuration
+        (
+            const std::string& testName,
+            unsigned long long& durationMs
+        )
+        const
+        {
+            std::map<std::string, Record>::const_iterator it = m_records.find( testName );
+            if( it == m_records.end() )
+                return false;
+            durationMs = it->second.m_durationMs;
+            return true;
+        }
+
+    private:
+        std::map<std::string, Record> m_records;
+    };
+
+} // end namespace Catch
+
+#endif // TWOBLUECUBES_CATCH_RUN_STATE_HPP_INCLUDED
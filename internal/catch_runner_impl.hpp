@@ -18,9 +18,21 @@
 #include "catch_test_registry.hpp"
 #include "catch_test_case_info.hpp"
 #include "catch_capture.hpp"
+#include "catch_message_arena.hpp"
+#include "catch_generators_impl.hpp"
+#include "catch_watchdog.hpp"
+#include "catch_fatal_signals.hpp"
+#include "catch_run_state.hpp"
+#include "catch_result_cache.hpp"
+#include "catch_random.hpp"
+#include "catch_timer.hpp"
+#include "catch_thread.hpp"
 
 #include <set>
 #include <string>
+#include <memory>
+#include <stdexcept>
+#include <algorithm>
 
 namespace Catch
 {
@@ -28,14 +40,17 @@ namespace Catch
     {
     public:
         ///////////////////////////////////////////////////////////////////////        
+        // A trailing '*' matches any ending - unless wildcards are not allowed,
+        // for names that are to be matched exactly
         TestSpec
         (
-            const std::string& rawSpec
+            const std::string& rawSpec,
+            bool allowWildcard = true
         )
         :   m_rawSpec( rawSpec ),
             m_isWildcarded( false )
         {
-            if( m_rawSpec[m_rawSpec.size()-1] == '*' )
+            if( allowWildcard && !m_rawSpec.empty() && m_rawSpec[m_rawSpec.size()-1] == '*' )
             {
                 m_rawSpec = m_rawSpec.substr( 0, m_rawSpec.size()-1 );
                 m_isWildcarded = true;
@@ -162,11 +177,73 @@ namespace Catch
     ///////////////////////////////////////////////////////////////////////////
     ///////////////////////////////////////////////////////////////////////////    
 
-    class Runner : public IResultCapture, public IRunner
+    class Runner : public IResultCapture, public IRunner, private ITimeoutHandler, private IFatalSignalHandler
     {
         Runner( const Runner& );
         void operator =( const Runner& );
         
+        struct OpenSection
+        {
+            std::string m_name;
+            std::size_t m_prevSuccesses;
+            std::size_t m_prevFailures;
+        };
+        
+        // Runs some of a test case's generated values on a thread of its own,
+        // taking the next one to run from the Runner each time
+        class GeneratorWorker : public IRunnable, NonCopyable
+        {
+        public:
+            ///////////////////////////////////////////////////////////////////////
+            GeneratorWorker
+            (
+                Runner& runner,
+                const GeneratorsForTest& generators
+            )
+            :   m_runner( runner )
+            {
+                m_generators.copyGeneratorsFrom( generators );
+            }
+            
+            ///////////////////////////////////////////////////////////////////////
+            virtual void run
+            ()
+            {
+                m_runner.m_isGeneratorThread.get() = true;
+                HubContext hubContext( &m_runner, &m_runner );
+                hubContext.setGenerators( &m_generators );
+                hubContext.setRngSeed( m_runner.m_config.getRngSeed() );
+                hubContext.setFpTolerance( m_runner.m_config.getFpTolerance() );
+                HubContext* prevHubContext = Hub::enterContext( &hubContext );
+                
+                std::size_t combination;
+                while( m_runner.takeNextCombination( combination ) )
+                {
+                    m_generators.moveTo( combination );
+                    m_runner.invokeCurrentTest();
+                    // The failure has been reported - the rest of the
+                    // combinations can't be run properly either
+                    if( m_generators.sawUnknownSite() )
+                    {
+                        m_runner.abandonCombinations();
+                        break;
+                    }
+                }
+                
+                if( hubContext.wasRngSeedUsed() )
+                {
+                    ScopedLock lock( m_runner.m_mutex );
+                    m_runner.m_hubContext.setRngSeedUsed( true );
+                }
+                Hub::leaveContext( &hubContext, prevHubContext );
+            }
+            
+        private:
+            Runner& m_runner;
+            GeneratorsForTest m_generators;
+        };
+        friend class GeneratorWorker;
+        
     public:
 
         ///////////////////////////////////////////////////////////////////////////
@@ -178,11 +255,27 @@ namespace Catch
             m_successes( 0 ),
             m_failures( 0 ),
             m_reporter( m_config.getReporter() ),
-            m_prevRunner( &Hub::getRunner() ),
-            m_prevResultCapture( &Hub::getResultCapture() )
+            m_groupOpen( false ),
+            m_quietSections( false ),
+            m_quietSuccesses( false ),
+            m_quietResults( false ),
+            m_lastLine( 0 ),
+            m_timeoutArmed( false ),
+            m_runEnded( false ),
+            m_hubContext( this, this ),
+            m_prevHubContext( Hub::enterContext( &m_hubContext ) ),
+            m_testThread( getCurrentThreadId() ),
+            m_nextCombination( 0 ),
+            m_combinationCount( 0 )
         {
-            Hub::setRunner( this );
-            Hub::setResultCapture( this );
+            m_hubContext.setRngSeed( m_config.getRngSeed() );
+            m_hubContext.setFpTolerance( m_config.getFpTolerance() );
+            if( !m_config.getStateFilename().empty() )
+                m_runState.load( m_config.getStateFilename() );
+            // Repeated runs are for shaking out failures, which a cached pass
+            // would hide
+            if( !m_config.getCacheDir().empty() && !m_config.shouldRepeat() )
+                m_resultCache = std::auto_ptr<ResultCache>( new ResultCache( m_config.getCacheDir(), m_config.getBuildFingerprint() + "\n" + m_config.getOutcomeOptions() ) );
             m_reporter->StartTesting();
         }
         
@@ -191,8 +284,29 @@ namespace Catch
         ()
         {
             m_reporter->EndTesting( m_successes, m_failures );
-            Hub::setRunner( m_prevRunner );
-            Hub::setResultCapture( m_prevResultCapture );
+            saveRunState();
+            Hub::leaveContext( &m_hubContext, m_prevHubContext );
+        }
+        
+        ///////////////////////////////////////////////////////////////////////////
+        void startGroup
+        (
+            const std::string& groupName
+        )
+        {
+            m_groupName = groupName;
+            m_groupOpen = true;
+            m_groupPrevSuccesses = m_successes;
+            m_groupPrevFailures = m_failures;
+            m_reporter->StartGroup( groupName );
+        }
+        
+        ///////////////////////////////////////////////////////////////////////////
+        void endGroup
+        ()
+        {
+            m_groupOpen = false;
+            m_reporter->EndGroup( m_groupName, m_successes - m_groupPrevSuccesses, m_failures - m_groupPrevFailures );
         }
         
         ///////////////////////////////////////////////////////////////////////////
@@ -201,8 +315,8 @@ namespace Catch
             bool runHiddenTests = false
         )
         {
-            std::vector<TestCaseInfo> allTests = Hub::getTestCaseRegistry().getAllTests();
-            for( std::size_t i=0; i < allTests.size(); ++i )
+            std::vector<TestCaseInfo> allTests = getAllTestsInOrder();
+            for( std::size_t i=0; i < allTests.size() && !aborting(); ++i )
             {
                 if( runHiddenTests || !allTests[i].isHidden() )
                    runTest( allTests[i] );
@@ -215,11 +329,28 @@ namespace Catch
             const std::string& rawTestSpec
         )
         {
-            TestSpec testSpec( rawTestSpec );
-            
-            std::vector<TestCaseInfo> allTests = Hub::getTestCaseRegistry().getAllTests();
+            return runTestsMatching( TestSpec( rawTestSpec ) );
+        }
+        
+        ///////////////////////////////////////////////////////////////////////////
+        // Runs the test case with exactly this name, even if it ends in '*'
+        std::size_t runNamed
+        (
+            const std::string& testName
+        )
+        {
+            return runTestsMatching( TestSpec( testName, false ) );
+        }
+        
+        ///////////////////////////////////////////////////////////////////////////
+        std::size_t runTestsMatching
+        (
+            const TestSpec& testSpec
+        )
+        {
+            std::vector<TestCaseInfo> allTests = getAllTestsInOrder();
             std::size_t testsRun = 0;
-            for( std::size_t i=0; i < allTests.size(); ++i )
+            for( std::size_t i=0; i < allTests.size() && !aborting(); ++i )
             {
                 if( testSpec.matches( allTests[i].getName() ) )
                 {
@@ -236,6 +367,10 @@ namespace Catch
             const TestCaseInfo& testInfo
         )
         {
+            std::size_t cachedSuccesses = 0;
+            if( m_resultCache.get() && !m_config.shouldRefreshCache() && m_resultCache->lookup( testInfo.getName(), cachedSuccesses ) )
+                return reportCachedPass( testInfo, cachedSuccesses );
+
             std::size_t prevSuccessCount = m_successes;
             std::size_t prevFailureCount = m_failures;
 
@@ -244,24 +379,66 @@ namespace Catch
             
             m_reporter->StartTestCase( testInfo );
             
-            m_runningTest = RunningTest( &testInfo );
+            m_hubContext.setRngSeedUsed( false );
+            m_testPrevSuccesses = prevSuccessCount;
+            m_testPrevFailures = prevFailureCount;
+            m_testTimer.start();
+
+            // When repeating, only the first iteration and the failures of the
+            // first iteration to fail are reported (without their sections) -
+            // the rest just add to the counts
+            std::size_t repeatCount = m_config.getRepeatCount();
+            bool repeating = m_config.shouldRepeat();
+            std::size_t iterations = 0;
+            std::size_t failedIterations = 0;
+            m_quietSections = repeating;
 
             do
             {
-                do
-                {
-                    m_runningTest.resetSectionSeen();
-                    runCurrentTest( redirectedCout, redirectedCerr );
-                }
-                while( m_runningTest.wasSectionSeen() );
+                std::size_t iterationPrevFailures = m_failures;
+                m_quietSuccesses = iterations > 0;
+                m_quietResults = failedIterations > 0;
+                runIteration( testInfo, redirectedCout, redirectedCerr );
+                iterations++;
+                if( m_failures > iterationPrevFailures )
+                    failedIterations++;
             }
-            while( Hub::advanceGeneratorsForCurrentTest() );
+            while( repeating &&
+                    ( repeatCount == 0 || iterations < repeatCount ) &&
+                    !( failedIterations > 0 && m_config.shouldRepeatUntilFailure() ) &&
+                    !aborting() );
 
-            m_runningTest = RunningTest();
+            m_quietSections = false;
+            m_quietSuccesses = false;
+            m_quietResults = false;
+            if( repeating && ( failedIterations > 0 || m_config.includeSuccessfulResults() ) )
+                reportIterations( iterations, failedIterations );
+            if( m_failures > prevFailureCount && m_hubContext.wasRngSeedUsed() && !m_config.isRngSeedReported() )
+                reportRngSeed();
 
+            m_runState.record( testInfo.getName(), m_failures == prevFailureCount, m_testTimer.getElapsedMilliseconds() );
+            if( m_resultCache.get() )
+            {
+                // A pass with a seed picked for this run says nothing about
+                // the next run's seed
+                bool usedChosenSeed = m_hubContext.wasRngSeedUsed() && !m_config.isRngSeedGiven();
+                if( m_failures == prevFailureCount && !usedChosenSeed )
+                    m_resultCache->store( testInfo.getName(), m_successes - prevSuccessCount );
+                else
+                    m_resultCache->remove( testInfo.getName() );
+            }
             m_reporter->EndTestCase( testInfo, m_successes - prevSuccessCount, m_failures - prevFailureCount, redirectedCout, redirectedCerr );
         }
         
+        ///////////////////////////////////////////////////////////////////////////
+        // True once enough tests have failed that no more should be started
+        bool aborting
+        ()
+        const
+        {
+            return m_config.getAbortAfter() > 0 && m_failures >= m_config.getAbortAfter();
+        }
+        
         ///////////////////////////////////////////////////////////////////////////
         virtual std::size_t getSuccessCount
         ()
@@ -295,13 +472,16 @@ namespace Catch
             ResultWas::OfType result
         )
         {
-            m_currentResult.setResultType( result );            
-            testEnded( m_currentResult );
+            ResultInfo& currentResult = m_currentResult.get();
+            currentResult.setResultType( result );
+            testEnded( currentResult );
 
-            bool ok = m_currentResult.ok();
-            m_currentResult = ResultInfo();
+            bool ok = currentResult.ok();
+            currentResult = ResultInfo();
             if( ok )
                 return ResultAction::None;
+            else if( !isSameThread( getCurrentThreadId(), m_testThread ) && !m_isGeneratorThread.get() )
+                return ResultAction::FailedOnWorkerThread;
             else if( shouldDebugBreak() )
                 return ResultAction::DebugFailed;
             else
@@ -314,7 +494,7 @@ namespace Catch
         ()
         const
         {
-            return m_currentResult;
+            return m_currentResult.get();
         }
 
         ///////////////////////////////////////////////////////////////////////////
@@ -323,7 +503,7 @@ namespace Catch
             const ResultInfo& resultInfo
         )
         {
-            m_currentResult = resultInfo;
+            m_currentResult.get() = resultInfo;
         }
 
         ///////////////////////////////////////////////////////////////////////////
@@ -332,7 +512,7 @@ namespace Catch
             const std::string& msg
         )
         {
-            m_currentResult.setMessage( msg );
+            m_currentResult.get().setMessage( msg );
         }
                 
         ///////////////////////////////////////////////////////////////////////////
@@ -341,6 +521,14 @@ namespace Catch
             const ResultInfo& result        
         )
         { 
+            ScopedLock lock( m_mutex );
+            // Once a timeout has ended the run the reporter has had all it is
+            // going to get - anything the stuck test goes on to do is dropped
+            if( m_runEnded )
+                return;
+            m_lastFilename = result.getFilename();
+            m_lastLine = result.getLine();
+
             if( result.getResultType() == ResultWas::Ok )
             {
                 m_successes++;
@@ -349,16 +537,17 @@ namespace Catch
             {
                 m_failures++;
 
-                std::vector<ResultInfo>::const_iterator it = m_info.begin();
-                std::vector<ResultInfo>::const_iterator itEnd = m_info.end();
-                for(; it != itEnd; ++it )
-                    m_reporter->Result( *it );
+                if( !m_quietResults )
+                {
+                    m_info.report( *m_reporter );
+                    reportScopedInfos();
+                }
                 m_info.clear();
             }
             
             if( result.getResultType() == ResultWas::Info )
-                m_info.push_back( result );
-            else
+                m_info.add( result );
+            else if( !m_quietResults && !( m_quietSuccesses && result.ok() ) )
                 m_reporter->Result( result );
         }
 
@@ -371,13 +560,33 @@ namespace Catch
             std::size_t& failures 
         )
         {
+            ScopedLock lock( m_mutex );
+            if( m_runEnded )
+                return false;
+
+            // Values are only shared out between threads when the first run
+            // saw no sections. The threads can't share out the runs a section
+            // needs as well, so one that turns up later fails the test case
+            if( m_isGeneratorThread.get() )
+            {
+                abandonCombinations();
+                throw std::logic_error( "SECTION \"" + name + "\" was reached that the first run of the test case didn't reach, "
+                                        "so generated values can't be shared out between threads. Run this test case without --generator-threads" );
+            }
             if( m_runningTest.wasSectionSeen() || !m_runningTest.addSection( name ) )
                 return false;
 
-            m_reporter->StartSection( name, description );
+            if( !m_quietSections )
+                m_reporter->StartSection( name, description );
             successes = m_successes;
             failures = m_failures;
             
+            OpenSection openSection;
+            openSection.m_name = name;
+            openSection.m_prevSuccesses = successes;
+            openSection.m_prevFailures = failures;
+            m_openSections.push_back( openSection );
+            
             // !TBD look up whether we should execute this section or not
             return true;
         }
@@ -390,7 +599,13 @@ namespace Catch
             std::size_t prevFailures 
         )
         {
-            m_reporter->EndSection( name, m_successes - prevSuccesses, m_failures - prevFailures );
+            ScopedLock lock( m_mutex );
+            if( m_runEnded )
+                return;
+            if( !m_openSections.empty() )
+                m_openSections.pop_back();
+            if( !m_quietSections )
+                m_reporter->EndSection( name, m_successes - prevSuccesses, m_failures - prevFailures );
         }
 
         ///////////////////////////////////////////////////////////////////////////
@@ -399,7 +614,7 @@ namespace Catch
             ScopedInfo* scopedInfo 
         )
         {
-            m_scopedInfos.push_back( scopedInfo );
+            m_scopedInfos.get().push_back( scopedInfo );
         }
 
         ///////////////////////////////////////////////////////////////////////////
@@ -408,8 +623,9 @@ namespace Catch
             ScopedInfo* scopedInfo
         )
         {
-            if( m_scopedInfos.back() == scopedInfo )
-                m_scopedInfos.pop_back();
+            std::vector<ScopedInfo*>& scopedInfos = m_scopedInfos.get();
+            if( !scopedInfos.empty() && scopedInfos.back() == scopedInfo )
+                scopedInfos.pop_back();
         }
 
         ///////////////////////////////////////////////////////////////////////////
@@ -428,7 +644,337 @@ namespace Catch
             return m_runningTest.getTestCaseInfo().getName();
         }
         
+    private: // ITimeoutHandler
+        
+        ///////////////////////////////////////////////////////////////////////////
+        virtual void timedOut
+        (
+            unsigned int seconds
+        )
+        {
+            // Held until the process exits, so the test's own threads can't
+            // report anything more while the run is being ended
+            ScopedLock lock( m_mutex );
+            // The test may have finished just as the time ran out
+            if( !m_timeoutArmed )
+                return;
+            std::ostringstream oss;
+            oss << "Test case timed out after " << seconds << " second(s)";
+            reportFatalError( "TIMEOUT", oss.str() );
+            exitImmediately( static_cast<int>( m_failures ) );
+        }
+        
+    private: // IFatalSignalHandler
+        
+        ///////////////////////////////////////////////////////////////////////////
+        // Only ever called on the test thread - faults on other threads are
+        // just written to stderr. Best effort: the reporter may well have been
+        // what faulted
+        virtual void fatalSignal
+        (
+            const std::string& signalName
+        )
+        {
+            ScopedLock lock( m_mutex );
+            reportFatalError( "FATAL_SIGNAL", "Fatal error: " + signalName );
+        }
+        
     private:
+
+        ///////////////////////////////////////////////////////////////////////////
+        // Reports the SCOPED_INFOs the failing thread is within, outermost
+        // first. This is the only time they are formatted
+        void reportScopedInfos
+        ()
+        {
+            const std::vector<ScopedInfo*>* scopedInfos = m_scopedInfos.find();
+            if( !scopedInfos )
+                return;
+            std::vector<ScopedInfo*>::const_iterator it = scopedInfos->begin();
+            std::vector<ScopedInfo*>::const_iterator itEnd = scopedInfos->end();
+            for(; it != itEnd; ++it )
+            {
+                ResultInfo info( "", ResultWas::Info, false, (*it)->getFilename(), (*it)->getLine(), "SCOPED_INFO" );
+                info.setMessage( (*it)->getInfo() );
+                m_reporter->Result( info );
+            }
+        }
+
+        ///////////////////////////////////////////////////////////////////////////
+        // Fails the current test case, at whichever section it has got to -
+        // and where it last made an assertion. The test can't be resumed, so
+        // what we have is reported and the run is ended here
+        void reportFatalError
+        (
+            const std::string& macroName,
+            const std::string& message
+        )
+        {
+            m_quietResults = false;
+            std::ostringstream oss;
+            oss << message;
+            if( !m_openSections.empty() )
+            {
+                oss << " in section: '";
+                for( std::size_t i = 0; i < m_openSections.size(); ++i )
+                    oss << ( i > 0 ? "/" : "" ) << m_openSections[i].m_name;
+                oss << "'";
+            }
+            acceptExpression( ResultInfo( "", ResultWas::Unknown, false, m_lastFilename.c_str(), m_lastLine, macroName.c_str() ) );
+            acceptMessage( oss.str() );
+            acceptResult( ResultWas::ThrewException );
+            endRunPrematurely();
+        }
+        
+    private:
+        
+        ///////////////////////////////////////////////////////////////////////////
+        // Closes off everything the reporter has been told about, so its output is
+        // complete (e.g. well formed XML), then flushes it
+        void endRunPrematurely
+        ()
+        {
+            while( !m_openSections.empty() )
+            {
+                const OpenSection& section = m_openSections.back();
+                if( !m_quietSections )
+                    m_reporter->EndSection( section.m_name, m_successes - section.m_prevSuccesses, m_failures - section.m_prevFailures );
+                m_openSections.pop_back();
+            }
+            m_runState.record( m_runningTest.getTestCaseInfo().getName(), false, m_testTimer.getElapsedMilliseconds() );
+            m_reporter->EndTestCase( m_runningTest.getTestCaseInfo(), m_successes - m_testPrevSuccesses, m_failures - m_testPrevFailures, "", "" );
+            if( m_groupOpen )
+                endGroup();
+            m_reporter->EndTesting( m_successes, m_failures );
+            m_runEnded = true;
+            m_config.flush();
+            saveRunState();
+        }
+        
+        ///////////////////////////////////////////////////////////////////////////
+        // Runs the test case once - or rather, as many times as it takes to get
+        // through all of its sections and generated values
+        void runIteration
+        (
+            const TestCaseInfo& testInfo,
+            std::string& redirectedCout,
+            std::string& redirectedCerr
+        )
+        {
+            m_runningTest = RunningTest( &testInfo );
+            GeneratorsForTest generators( m_config.getCombination() );
+            m_hubContext.setGenerators( &generators );
+
+            unsigned int timeout = testInfo.getTimeout() > 0 ? testInfo.getTimeout() : m_config.getTimeout();
+            if( timeout > 0 )
+            {
+                if( !m_watchdog.get() )
+                    m_watchdog = std::auto_ptr<Watchdog>( new Watchdog( *this ) );
+                ScopedLock lock( m_mutex );
+                m_timeoutArmed = true;
+                m_watchdog->arm( timeout );
+            }
+
+            bool firstRun = true;
+            do
+            {
+                do
+                {
+                    m_runningTest.resetSectionSeen();
+                    runCurrentTest( redirectedCout, redirectedCerr );
+                }
+                while( m_runningTest.wasSectionSeen() );
+                
+                // The first run finds the generators. If there are no sections
+                // to work through as well, the rest can be shared out
+                if( firstRun &&
+                    m_config.getGeneratorThreads() > 1 &&
+                    m_runningTest.sectionsSeenCount() == 0 &&
+                    generators.getCombinationCount() > 1 )
+                {
+                    runCombinationsInParallel( generators );
+                    break;
+                }
+                firstRun = false;
+            }
+            while( generators.moveNext() );
+
+            if( timeout > 0 )
+            {
+                ScopedLock lock( m_mutex );
+                m_timeoutArmed = false;
+                m_watchdog->disarm();
+            }
+            
+            m_hubContext.setGenerators( NULL );
+            m_runningTest = RunningTest();
+        }
+        
+        ///////////////////////////////////////////////////////////////////////////
+        // For a failing test that drew random numbers from a seed the
+        // reporters don't otherwise show
+        void reportRngSeed
+        ()
+        {
+            std::ostringstream oss;
+            oss << "Randomness seeded to: " << m_config.getRngSeed()
+                << " - rerun with --rng-seed " << m_config.getRngSeed() << " to reproduce";
+            ResultInfo result( "", ResultWas::Info, false, "", 0, "RNG" );
+            result.setMessage( oss.str() );
+            m_reporter->Result( result );
+        }
+        
+        ///////////////////////////////////////////////////////////////////////////
+        void reportIterations
+        (
+            std::size_t iterations,
+            std::size_t failedIterations
+        )
+        {
+            std::ostringstream oss;
+            if( failedIterations == 0 )
+                oss << "Passed all " << iterations << " iteration(s)";
+            else
+                oss << "Failed in " << failedIterations << " of " << iterations << " iteration(s) ("
+                    << ( 100.0 * failedIterations / iterations ) << "%)";
+            ResultInfo result( "", ResultWas::Info, false, "", 0, "REPEAT" );
+            result.setMessage( oss.str() );
+            m_reporter->Result( result );
+        }
+        
+        ///////////////////////////////////////////////////////////////////////////
+        // Every registered test, in the order they should be run. A random order
+        // depends only on the seed, so every group is shuffled the same way
+        std::vector<TestCaseInfo> getAllTestsInOrder
+        ()
+        const
+        {
+            std::vector<TestCaseInfo> allTests = Hub::getTestCaseRegistry().getAllTests();
+            switch( m_config.getOrder() )
+            {
+                case Config::Order::Lexical:
+                    std::sort( allTests.begin(), allTests.end() );
+                    break;
+                case Config::Order::Random:
+                    {
+                        RandomNumberGenerator rng( m_config.getRngSeed() );
+                        shuffle( allTests, rng );
+                    }
+                    break;
+                case Config::Order::Declared:
+                    break;
+            }
+            return allTests;
+        }
+        
+        ///////////////////////////////////////////////////////////////////////////
+        // Reports a test case as passing, without running it, as it did last time
+        void reportCachedPass
+        (
+            const TestCaseInfo& testInfo,
+            std::size_t successes
+        )
+        {
+            m_reporter->StartTestCase( testInfo );
+            if( m_config.includeSuccessfulResults() )
+            {
+                std::ostringstream oss;
+                oss << "Not run - passed last time, with the same build and options (" << successes << " assertion(s))";
+                ResultInfo result( "", ResultWas::Info, false, "", 0, "CACHED" );
+                result.setMessage( oss.str() );
+                m_reporter->Result( result );
+            }
+            m_successes += successes;
+
+            // It still passed, and took as long as it did when it was run
+            unsigned long long durationMs = 0;
+            m_runState.getDuration( testInfo.getName(), durationMs );
+            m_runState.record( testInfo.getName(), true, durationMs );
+            m_reporter->EndTestCase( testInfo, successes, 0, "", "" );
+        }
+        
+        ///////////////////////////////////////////////////////////////////////////
+        void saveRunState
+        ()
+        {
+            const std::string& filename = m_config.getStateFilename();
+            if( !filename.empty() && !m_runState.save( filename ) )
+                std::cerr << "Unable to write state file: '" << filename << "'" << std::endl;
+        }
+        
+        ///////////////////////////////////////////////////////////////////////////
+        // Runs all but the first combination of generated values across worker
+        // threads. Output to stdout/ stderr is not captured while they run, as
+        // the streams can only be redirected for the whole process
+        void runCombinationsInParallel
+        (
+            GeneratorsForTest& generators
+        )
+        {
+            {
+                ScopedLock lock( m_mutex );
+                m_nextCombination = 1;
+                m_combinationCount = generators.getCombinationCount();
+            }
+            std::size_t threadCount = (std::min)( m_config.getGeneratorThreads(), m_combinationCount-1 );
+            
+            FatalSignalGuard signalGuard( *this );
+            std::vector<GeneratorWorker*> workers;
+            std::vector<Thread*> threads;
+            for( std::size_t i = 0; i < threadCount; ++i )
+            {
+                workers.push_back( new GeneratorWorker( *this, generators ) );
+                threads.push_back( new Thread( *workers.back() ) );
+            }
+            deleteAll( threads );
+            deleteAll( workers );
+        }
+        
+        ///////////////////////////////////////////////////////////////////////////
+        bool takeNextCombination
+        (
+            std::size_t& combination
+        )
+        {
+            ScopedLock lock( m_mutex );
+            if( m_nextCombination >= m_combinationCount || aborting() )
+                return false;
+            combination = m_nextCombination++;
+            return true;
+        }
+        
+        ///////////////////////////////////////////////////////////////////////////
+        void abandonCombinations
+        ()
+        {
+            ScopedLock lock( m_mutex );
+            m_nextCombination = m_combinationCount;
+        }
+        
+        ///////////////////////////////////////////////////////////////////////////
+        // A single run of the test case on a generator worker thread
+        void invokeCurrentTest
+        ()
+        {
+            try
+            {
+                m_runningTest.getTestCaseInfo().invoke();
+            }
+            catch( TestFailureException& )
+            {
+                // This just means the test was aborted due to failure
+            }
+            catch( std::exception& ex )
+            {
+                acceptMessage( ex.what() );
+                acceptResult( ResultWas::ThrewException );
+            }
+            catch(...)
+            {
+                acceptMessage( "unknown exception" );
+                acceptResult( ResultWas::ThrewException );
+            }
+        }
         
         ///////////////////////////////////////////////////////////////////////////
         void runCurrentTest
@@ -439,6 +985,7 @@ namespace Catch
         {            
             try
             {
+                FatalSignalGuard signalGuard( *this );
                 StreamRedirect coutRedir( std::cout, redirectedCout );
                 StreamRedirect cerrRedir( std::cerr, redirectedCerr );
                 m_runningTest.getTestCaseInfo().invoke();                
@@ -457,21 +1004,49 @@ namespace Catch
                 acceptMessage( "unknown exception" );
                 acceptResult( ResultWas::ThrewException );
             }
+            ScopedLock lock( m_mutex );
             m_info.clear();
+            m_openSections.clear();
         }
         
     private:
         RunningTest m_runningTest;
-        ResultInfo m_currentResult;
+        // Assertions may be made from threads the test starts, so each thread
+        // builds up its own result, and the rest is guarded by m_mutex
+        mutable ThreadLocal<ResultInfo> m_currentResult;
+        Mutex m_mutex;
 
         const Config& m_config;
         std::size_t m_successes;
         std::size_t m_failures;
         IReporter* m_reporter;
-        std::vector<ScopedInfo*> m_scopedInfos;
-        std::vector<ResultInfo> m_info;
-        IRunner* m_prevRunner;
-        IResultCapture* m_prevResultCapture;
+        std::string m_groupName;
+        bool m_groupOpen;
+        std::size_t m_groupPrevSuccesses;
+        std::size_t m_groupPrevFailures;
+        std::size_t m_testPrevSuccesses;
+        std::size_t m_testPrevFailures;
+        bool m_quietSections;
+        bool m_quietSuccesses;
+        bool m_quietResults;
+        std::vector<OpenSection> m_openSections;
+        std::string m_lastFilename;
+        std::size_t m_lastLine;
+        std::auto_ptr<Watchdog> m_watchdog;
+        bool m_timeoutArmed;
+        bool m_runEnded;
+        Timer m_testTimer;
+        RunState m_runState;
+        std::auto_ptr<ResultCache> m_resultCache;
+        // Each thread's SCOPED_INFOs are its own, and only it reads them
+        ThreadLocal<std::vector<ScopedInfo*> > m_scopedInfos;
+        InfoLog m_info;
+        HubContext m_hubContext;
+        HubContext* m_prevHubContext;
+        ThreadId m_testThread;
+        ThreadLocal<bool> m_isGeneratorThread;
+        std::size_t m_nextCombination;
+        std::size_t m_combinationCount;
     };
 }
 
@@ -140,6 +140,17 @@ namespace Catch
             return result;
         }
 
+        ///////////////////////////////////////////////////////////////////////////
+        std::size_t runNamed
+        (
+            const std::string& testName
+        )
+        {
+            Runner runner( m_config );
+            m_config.getReporter().reset();
+            return runner.runNamed( testName );
+        }
+
         ///////////////////////////////////////////////////////////////////////////
         SelfTestReporter& getReporter
         ()
@@ -15,6 +15,20 @@
 
 #include <stdexcept>
 #include <cstdio>
+#include <iostream>
+#include <string>
+
+inline void writeToDebugConsole( const std::string& text )
+{
+    // !TBD: Get Windows version working
+    // - need to declare OutputDebugStringA without Windows.h
+//#ifdef _WIN32
+//    ::OutputDebugStringA( text.c_str() );    
+//#else
+    // !TBD: Need a version for Mac/ XCode and other IDEs
+    std::cout << text;
+//#endif
+}
 
 namespace Catch
 {    
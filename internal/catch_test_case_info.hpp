@@ -16,6 +16,7 @@
 #include "catch_interfaces_testcase.h"
 #include <map>
 #include <string>
+#include <vector>
 
 namespace Catch
 {
@@ -27,18 +28,26 @@ namespace Catch
         (
             ITestCase* testCase, 
             const char* name, 
-            const char* description 
+            const char* description,
+            unsigned int timeout = 0,
+            const char* filename = "",
+            std::size_t line = 0
         )
         :   m_test( testCase ),
             m_name( name ),
-            m_description( description )
+            m_description( description ),
+            m_timeout( timeout ),
+            m_filename( filename ),
+            m_line( line )
         {
         }
 
         ///////////////////////////////////////////////////////////////////////
         TestCaseInfo
         ()
-        :   m_test( NULL )
+        :   m_test( NULL ),
+            m_timeout( 0 ),
+            m_line( 0 )
         {
         }
         
@@ -49,7 +58,10 @@ namespace Catch
         )
         :   m_test( other.m_test->clone() ),
             m_name( other.m_name ),
-            m_description( other.m_description )
+            m_description( other.m_description ),
+            m_timeout( other.m_timeout ),
+            m_filename( other.m_filename ),
+            m_line( other.m_line )
         {
         }
         
@@ -61,7 +73,10 @@ namespace Catch
         )
         :   m_test( other.m_test->clone() ),
             m_name( name ),
-            m_description( other.m_description )
+            m_description( other.m_description ),
+            m_timeout( other.m_timeout ),
+            m_filename( other.m_filename ),
+            m_line( other.m_line )
         {
         }
         
@@ -107,6 +122,53 @@ namespace Catch
             return m_description;
         }
 
+        ///////////////////////////////////////////////////////////////////////
+        // Timeout in seconds, or zero if the test case doesn't specify one
+        unsigned int getTimeout
+        ()
+        const
+        {
+            return m_timeout;
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // Where the test case was registered, if known
+        const std::string& getFilename
+        ()
+        const
+        {
+            return m_filename;
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        std::size_t getLine
+        ()
+        const
+        {
+            return m_line;
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // The tags are any words in square brackets in the description, e.g.
+        // "Parses the headers [http] [slow]" has the tags "http" and "slow"
+        std::vector<std::string> getTags
+        ()
+        const
+        {
+            std::vector<std::string> tags;
+            std::string::size_type start = m_description.find( '[' );
+            while( start != std::string::npos )
+            {
+                std::string::size_type end = m_description.find( ']', start+1 );
+                if( end == std::string::npos )
+                    break;
+                if( end > start+1 )
+                    tags.push_back( m_description.substr( start+1, end-start-1 ) );
+                start = m_description.find( '[', end+1 );
+            }
+            return tags;
+        }
+
         ///////////////////////////////////////////////////////////////////////
         bool isHidden
         ()
@@ -124,6 +186,9 @@ namespace Catch
             std::swap( m_test, other.m_test );
             m_name.swap( other.m_name );
             m_description.swap( other.m_description );
+            std::swap( m_timeout, other.m_timeout );
+            m_filename.swap( other.m_filename );
+            std::swap( m_line, other.m_line );
         }
         
         ///////////////////////////////////////////////////////////////////////
@@ -155,6 +220,9 @@ namespace Catch
         ITestCase* m_test;
         std::string m_name;
         std::string m_description;
+        unsigned int m_timeout;
+        std::string m_filename;
+        std::size_t m_line;
     };
     
 }
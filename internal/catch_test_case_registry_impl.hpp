@@ -9,6 +9,8 @@
  *  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
  *
  */
+#ifndef TWOBLUECUBES_CATCH_TEST_CASE_REGISTRY_IMPL_HPP_INCLUDED
+#define TWOBLUECUBES_CATCH_TEST_CASE_REGISTRY_IMPL_HPP_INCLUDED
 
 #include "catch_test_registry.hpp"
 #include "catch_test_case_info.hpp"
@@ -128,10 +130,26 @@ namespace Catch
     (
         TestFunction function, 
         const char* name,
-        const char* description
+        const char* description,
+        const char* filename,
+        std::size_t line
     )
     {
-        registerTestCase( new FreeFunctionTestCase( function ), name, description );
+        registerTestCase( new FreeFunctionTestCase( function ), name, description, 0, filename, line );
+    }    
+    
+    ///////////////////////////////////////////////////////////////////////////
+    AutoReg::AutoReg
+    (
+        TestFunction function, 
+        const char* name,
+        const char* description,
+        unsigned int timeout,
+        const char* filename,
+        std::size_t line
+    )
+    {
+        registerTestCase( new FreeFunctionTestCase( function ), name, description, timeout, filename, line );
     }    
     
     ///////////////////////////////////////////////////////////////////////////
@@ -145,11 +163,15 @@ namespace Catch
     (
         ITestCase* testCase, 
         const char* name, 
-        const char* description 
+        const char* description,
+        unsigned int timeout,
+        const char* filename,
+        std::size_t line
     )
     {
-        Hub::getTestCaseRegistry().registerTest( TestCaseInfo( testCase, name, description ) );
+        Hub::getTestCaseRegistry().registerTest( TestCaseInfo( testCase, name, description, timeout, filename, line ) );
     }
     
 } // end namespace Catch
 
+#endif // TWOBLUECUBES_CATCH_TEST_CASE_REGISTRY_IMPL_HPP_INCLUDED
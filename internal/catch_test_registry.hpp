@@ -79,7 +79,18 @@ struct AutoReg
     AutoReg
         (   TestFunction function, 
             const char* name, 
-            const char* description 
+            const char* description,
+            const char* filename,
+            std::size_t line
+        );
+    
+    AutoReg
+        (   TestFunction function, 
+            const char* name, 
+            const char* description,
+            unsigned int timeout,
+            const char* filename,
+            std::size_t line
         );
     
     ///////////////////////////////////////////////////////////////////////////
@@ -88,10 +99,12 @@ struct AutoReg
     (
         void (C::*method)(), 
         const char* name, 
-        const char* description
+        const char* description,
+        const char* filename,
+        std::size_t line
     )
     {
-        registerTestCase( new MethodTestCase<C>( method ), name, description );
+        registerTestCase( new MethodTestCase<C>( method ), name, description, 0, filename, line );
     }
     
     ///////////////////////////////////////////////////////////////////////////
@@ -99,7 +112,10 @@ struct AutoReg
     (
         ITestCase* testCase, 
         const char* name, 
-        const char* description
+        const char* description,
+        unsigned int timeout,
+        const char* filename,
+        std::size_t line
     );
     
     ~AutoReg
@@ -121,18 +137,24 @@ struct FixtureWrapper{};
 ///////////////////////////////////////////////////////////////////////////////
 #define INTERNAL_CATCH_TESTCASE( Name, Desc ) \
     static void INTERNAL_CATCH_UNIQUE_NAME( catch_internal_TestFunction )(); \
-    namespace{ Catch::AutoReg INTERNAL_CATCH_UNIQUE_NAME( autoRegistrar )( &INTERNAL_CATCH_UNIQUE_NAME(  catch_internal_TestFunction ), Name, Desc ); }\
+    namespace{ Catch::AutoReg INTERNAL_CATCH_UNIQUE_NAME( autoRegistrar )( &INTERNAL_CATCH_UNIQUE_NAME(  catch_internal_TestFunction ), Name, Desc, __FILE__, __LINE__ ); }\
     static void INTERNAL_CATCH_UNIQUE_NAME(  catch_internal_TestFunction )()
 
 ///////////////////////////////////////////////////////////////////////////////
 #define INTERNAL_CATCH_TESTCASE_NORETURN( Name, Desc ) \
     static void INTERNAL_CATCH_UNIQUE_NAME( catch_internal_TestFunction )() ATTRIBUTE_NORETURN; \
-    namespace{ Catch::AutoReg INTERNAL_CATCH_UNIQUE_NAME( autoRegistrar )( &INTERNAL_CATCH_UNIQUE_NAME(  catch_internal_TestFunction ), Name, Desc ); }\
+    namespace{ Catch::AutoReg INTERNAL_CATCH_UNIQUE_NAME( autoRegistrar )( &INTERNAL_CATCH_UNIQUE_NAME(  catch_internal_TestFunction ), Name, Desc, __FILE__, __LINE__ ); }\
+    static void INTERNAL_CATCH_UNIQUE_NAME(  catch_internal_TestFunction )()
+
+///////////////////////////////////////////////////////////////////////////////
+#define INTERNAL_CATCH_TESTCASE_TIMEOUT( Name, Desc, TimeoutSeconds ) \
+    static void INTERNAL_CATCH_UNIQUE_NAME( catch_internal_TestFunction )(); \
+    namespace{ Catch::AutoReg INTERNAL_CATCH_UNIQUE_NAME( autoRegistrar )( &INTERNAL_CATCH_UNIQUE_NAME(  catch_internal_TestFunction ), Name, Desc, TimeoutSeconds, __FILE__, __LINE__ ); }\
     static void INTERNAL_CATCH_UNIQUE_NAME(  catch_internal_TestFunction )()
 
 ///////////////////////////////////////////////////////////////////////////////
 #define CATCH_METHOD_AS_TEST_CASE( QualifiedMethod, Name, Desc ) \
-    namespace{ Catch::AutoReg INTERNAL_CATCH_UNIQUE_NAME( autoRegistrar )( &QualifiedMethod, Name, Desc ); }
+    namespace{ Catch::AutoReg INTERNAL_CATCH_UNIQUE_NAME( autoRegistrar )( &QualifiedMethod, Name, Desc, __FILE__, __LINE__ ); }
 
 ///////////////////////////////////////////////////////////////////////////////
 #define TEST_CASE_METHOD( ClassName, TestName, Desc )\
@@ -140,7 +162,7 @@ struct FixtureWrapper{};
     { \
         void test(); \
     }; }\
-    namespace { Catch::AutoReg INTERNAL_CATCH_UNIQUE_NAME( autoRegistrar ) ( &Catch::FixtureWrapper<ClassName, __LINE__>::test, TestName, Desc ); } \
+    namespace { Catch::AutoReg INTERNAL_CATCH_UNIQUE_NAME( autoRegistrar ) ( &Catch::FixtureWrapper<ClassName, __LINE__>::test, TestName, Desc, __FILE__, __LINE__ ); } \
     void Catch::FixtureWrapper<ClassName, __LINE__>::test()
 
 #endif // TWOBLUECUBES_CATCH_REGISTRY_HPP_INCLUDED
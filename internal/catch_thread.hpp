@@ -0,0 +1,324 @@
+/*
+ *  catch_thread.hpp
+ *  Catch
+ *
+ *  Created by the Catch contributors on 19/10/2026.
+ *  Copyright 2026 the Catch contributors. All rights reserved.
+ *
+ *  Distributed under the Boost Software License, Version 1.0. (See accompanying
+ *  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ *
+ * Minimal threading primitives - just enough for Catch's own needs.
+ * Uses Win32 threads on Windows and pthreads everywhere else
+ */
+#ifndef TWOBLUECUBES_CATCH_THREAD_HPP_INCLUDED
+#define TWOBLUECUBES_CATCH_THREAD_HPP_INCLUDED
+
+#include "catch_common.h"
+#include "catch_hub.h"
+
+#include <vector>
+
+#ifdef _WIN32
+    #ifndef NOMINMAX
+        #define NOMINMAX
+    #endif
+    #include <windows.h>
+#else
+    #include <pthread.h>
+    #include <sys/time.h>
+    #include <errno.h>
+#endif
+
+namespace Catch
+{
+    class Condition;
+
+    class Mutex : NonCopyable
+    {
+        friend class Condition;
+    public:
+#ifdef _WIN32
+        Mutex(){ InitializeCriticalSection( &m_mutex ); }
+        ~Mutex(){ DeleteCriticalSection( &m_mutex ); }
+        void lock(){ EnterCriticalSection( &m_mutex ); }
+        void unlock(){ LeaveCriticalSection( &m_mutex ); }
+    private:
+        CRITICAL_SECTION m_mutex;
+#else
+        // Recursive, like a critical section
+        Mutex()
+        {
+            pthread_mutexattr_t attr;
+            pthread_mutexattr_init( &attr );
+            pthread_mutexattr_settype( &attr, PTHREAD_MUTEX_RECURSIVE );
+            pthread_mutex_init( &m_mutex, &attr );
+            pthread_mutexattr_destroy( &attr );
+        }
+        ~Mutex(){ pthread_mutex_destroy( &m_mutex ); }
+        void lock(){ pthread_mutex_lock( &m_mutex ); }
+        void unlock(){ pthread_mutex_unlock( &m_mutex ); }
+    private:
+        pthread_mutex_t m_mutex;
+#endif
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    class ScopedLock : NonCopyable
+    {
+    public:
+        explicit ScopedLock( Mutex& mutex ) : m_mutex( mutex ){ m_mutex.lock(); }
+        ~ScopedLock(){ m_mutex.unlock(); }
+    private:
+        Mutex& m_mutex;
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    class Condition : NonCopyable
+    {
+    public:
+#ifdef _WIN32
+        Condition(){ InitializeConditionVariable( &m_cond ); }
+        ~Condition(){}
+        void wait( Mutex& mutex ){ SleepConditionVariableCS( &m_cond, &mutex.m_mutex, INFINITE ); }
+        bool waitFor( Mutex& mutex, unsigned int milliseconds )
+        {
+            return SleepConditionVariableCS( &m_cond, &mutex.m_mutex, milliseconds ) != 0;
+        }
+        void signal(){ WakeConditionVariable( &m_cond ); }
+        void broadcast(){ WakeAllConditionVariable( &m_cond ); }
+    private:
+        CONDITION_VARIABLE m_cond;
+#else
+        Condition(){ pthread_cond_init( &m_cond, NULL ); }
+        ~Condition(){ pthread_cond_destroy( &m_cond ); }
+        void wait( Mutex& mutex ){ pthread_cond_wait( &m_cond, &mutex.m_mutex ); }
+        // Returns false if the time elapsed without the condition being signalled
+        bool waitFor( Mutex& mutex, unsigned int milliseconds )
+        {
+            timeval now;
+            gettimeofday( &now, NULL );
+            timespec until;
+            until.tv_sec = now.tv_sec + milliseconds / 1000;
+            until.tv_nsec = now.tv_usec * 1000 + ( milliseconds % 1000 ) * 1000000;
+            if( until.tv_nsec >= 1000000000 )
+            {
+                until.tv_sec++;
+                until.tv_nsec -= 1000000000;
+            }
+            return pthread_cond_timedwait( &m_cond, &mutex.m_mutex, &until ) != ETIMEDOUT;
+        }
+        void signal(){ pthread_cond_signal( &m_cond ); }
+        void broadcast(){ pthread_cond_broadcast( &m_cond ); }
+    private:
+        pthread_cond_t m_cond;
+#endif
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    // A separate, lazily default constructed, T for each thread that asks for
+    // one. Each thread's T is deleted when the thread exits, and any that are
+    // left - those of threads still running - when the ThreadLocal is
+    // destroyed. So it must not be destroyed while those threads still use it
+    template<typename T>
+    class ThreadLocal : NonCopyable
+    {
+        // What each thread's slot points to - the owner is needed to forget
+        // the value when the thread exits
+        struct Slot
+        {
+            ThreadLocal* owner;
+            T* value;
+        };
+
+    public:
+#ifdef _WIN32
+        ThreadLocal(){ m_key = FlsAlloc( &ThreadLocal::release ); }
+        ~ThreadLocal(){ FlsFree( m_key ); deleteAll(); }
+    private:
+        Slot* findSlot() const { return static_cast<Slot*>( FlsGetValue( m_key ) ); }
+        void setSlot( Slot* slot ){ FlsSetValue( m_key, slot ); }
+        static void NTAPI release( void* slot ){ if( slot ) static_cast<Slot*>( slot )->owner->remove( static_cast<Slot*>( slot ) ); }
+        DWORD m_key;
+#else
+        ThreadLocal(){ pthread_key_create( &m_key, &ThreadLocal::release ); }
+        ~ThreadLocal(){ pthread_key_delete( m_key ); deleteAll(); }
+    private:
+        Slot* findSlot() const { return static_cast<Slot*>( pthread_getspecific( m_key ) ); }
+        void setSlot( Slot* slot ){ pthread_setspecific( m_key, slot ); }
+        static void release( void* slot ){ static_cast<Slot*>( slot )->owner->remove( static_cast<Slot*>( slot ) ); }
+        pthread_key_t m_key;
+#endif
+    public:
+        T* find() const
+        {
+            Slot* slot = findSlot();
+            return slot ? slot->value : NULL;
+        }
+
+        T& get()
+        {
+            Slot* slot = findSlot();
+            if( !slot )
+            {
+                slot = new Slot();
+                slot->owner = this;
+                slot->value = new T();
+                ScopedLock lock( m_mutex );
+                m_slots.push_back( slot );
+                setSlot( slot );
+            }
+            return *slot->value;
+        }
+
+    private:
+        void remove( Slot* slot )
+        {
+            ScopedLock lock( m_mutex );
+            for( std::size_t i = 0; i < m_slots.size(); ++i )
+            {
+                if( m_slots[i] == slot )
+                {
+                    m_slots[i] = m_slots.back();
+                    m_slots.pop_back();
+                    break;
+                }
+            }
+            delete slot->value;
+            delete slot;
+        }
+
+        void deleteAll()
+        {
+            ScopedLock lock( m_mutex );
+            for( std::size_t i = 0; i < m_slots.size(); ++i )
+            {
+                delete m_slots[i]->value;
+                delete m_slots[i];
+            }
+            m_slots.clear();
+        }
+
+        Mutex m_mutex;
+        std::vector<Slot*> m_slots;
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+#ifdef _WIN32
+    typedef DWORD ThreadId;
+    inline ThreadId getCurrentThreadId(){ return GetCurrentThreadId(); }
+    inline bool isSameThread( ThreadId lhs, ThreadId rhs ){ return lhs == rhs; }
+#else
+    typedef pthread_t ThreadId;
+    inline ThreadId getCurrentThreadId(){ return pthread_self(); }
+    inline bool isSameThread( ThreadId lhs, ThreadId rhs ){ return pthread_equal( lhs, rhs ) != 0; }
+#endif
+
+    ///////////////////////////////////////////////////////////////////////////
+    struct IRunnable
+    {
+        virtual ~IRunnable
+        ()
+        {}
+
+        virtual void run
+            () = 0;
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Runs an IRunnable on a new thread. The thread is joined on destruction.
+    // It reports to the same run as the thread that started it - so a test
+    // can start threads that make assertions
+    class Thread : NonCopyable
+    {
+    public:
+        ///////////////////////////////////////////////////////////////////////
+        explicit Thread
+        (
+            IRunnable& runnable
+        )
+        :   m_runnable( runnable ),
+            m_context( Hub::findCurrentContext() ),
+            m_running( false )
+        {
+#ifdef _WIN32
+            m_thread = CreateThread( NULL, 0, &Thread::threadProc, this, 0, NULL );
+            m_running = m_thread != NULL;
+#else
+            m_running = pthread_create( &m_thread, NULL, &Thread::threadProc, this ) == 0;
+#endif
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        ~Thread
+        ()
+        {
+            join();
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        bool isRunning
+        ()
+        const
+        {
+            return m_running;
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        void join
+        ()
+        {
+            if( !m_running )
+                return;
+#ifdef _WIN32
+            WaitForSingleObject( m_thread, INFINITE );
+            CloseHandle( m_thread );
+#else
+            pthread_join( m_thread, NULL );
+#endif
+            m_running = false;
+        }
+
+    private:
+        ///////////////////////////////////////////////////////////////////////
+        void run
+        ()
+        {
+            HubContext* prevContext = Hub::enterContext( m_context );
+            m_runnable.run();
+            Hub::leaveContext( m_context, prevContext );
+        }
+
+#ifdef _WIN32
+        ///////////////////////////////////////////////////////////////////////
+        static DWORD WINAPI threadProc
+        (
+            LPVOID thread
+        )
+        {
+            static_cast<Thread*>( thread )->run();
+            return 0;
+        }
+
+        HANDLE m_thread;
+#else
+        ///////////////////////////////////////////////////////////////////////
+        static void* threadProc
+        (
+            void* thread
+        )
+        {
+            static_cast<Thread*>( thread )->run();
+            return NULL;
+        }
+
+        pthread_t m_thread;
+#endif
+        IRunnable& m_runnable;
+        HubContext* m_context;
+        bool m_running;
+    };
+
+} // end namespace Catch
+
+#endif // TWOBLUECUBES_CATCH_THREAD_HPP_INCLUDED
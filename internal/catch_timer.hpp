@@ -0,0 +1,74 @@
+/*
+ *  catch_timer.hpp
+ *  Catch
+ *
+ *  Created by the Catch contributors on 19/10/2026.
+ *  Copyright 2026 the Catch contributors. All rights reserved.
+ *
+ *  Distributed under the Boost Software License, Version 1.0. (See accompanying
+ *  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ *
+ */
+#ifndef TWOBLUECUBES_CATCH_TIMER_HPP_INCLUDED
+#define TWOBLUECUBES_CATCH_TIMER_HPP_INCLUDED
+
+#ifdef _WIN32
+    #ifndef NOMINMAX
+        #define NOMINMAX
+    #endif
+    #include <windows.h>
+#else
+    #include <sys/time.h>
+#endif
+
+namespace Catch
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // Wall clock time, in milliseconds from some arbitrary starting point
+    inline unsigned long long getCurrentMilliseconds
+    ()
+    {
+#ifdef _WIN32
+        return GetTickCount64();
+#else
+        timeval now;
+        gettimeofday( &now, NULL );
+        return static_cast<unsigned long long>( now.tv_sec ) * 1000 + now.tv_usec / 1000;
+#endif
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    ///////////////////////////////////////////////////////////////////////////
+
+    class Timer
+    {
+    public:
+        ///////////////////////////////////////////////////////////////////////
+        Timer
+        ()
+        :   m_start( getCurrentMilliseconds() )
+        {
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        void start
+        ()
+        {
+            m_start = getCurrentMilliseconds();
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        unsigned long long getElapsedMilliseconds
+        ()
+        const
+        {
+            return getCurrentMilliseconds() - m_start;
+        }
+
+    private:
+        unsigned long long m_start;
+    };
+
+} // end namespace Catch
+
+#endif // TWOBLUECUBES_CATCH_TIMER_HPP_INCLUDED
@@ -0,0 +1,150 @@
+/*
+ *  catch_watchdog.hpp
+ *  Catch
+ *
+ *  Created by the Catch contributors on 19/10/2026.
+ *  Copyright 2026 the Catch contributors. All rights reserved.
+ *
+ *  Distributed under the Boost Software License, Version 1.0. (See accompanying
+ *  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ *
+ */
+#ifndef TWOBLUECUBES_CATCH_WATCHDOG_HPP_INCLUDED
+#define TWOBLUECUBES_CATCH_WATCHDOG_HPP_INCLUDED
+
+#include "catch_thread.hpp"
+#include "catch_timer.hpp"
+
+#include <stdlib.h>
+#ifndef _WIN32
+    #include <unistd.h>
+#endif
+
+namespace Catch
+{
+    struct ITimeoutHandler
+    {
+        virtual ~ITimeoutHandler
+        ()
+        {}
+
+        // Called on the watchdog's own thread. The thread being watched is
+        // presumed stuck, so this is not expected to return - unless it finds
+        // the test finished after all, in which case the watchdog waits to be
+        // armed again
+        virtual void timedOut
+            (   unsigned int seconds
+            ) = 0;
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Ends the process without running any more of the stuck program's code
+    inline void exitImmediately
+    (
+        int exitCode
+    )
+    {
+        _exit( exitCode );
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    ///////////////////////////////////////////////////////////////////////////
+
+    class Watchdog : private IRunnable
+    {
+    public:
+        ///////////////////////////////////////////////////////////////////////
+        explicit Watchdog
+        (
+            ITimeoutHandler& handler
+        )
+        :   m_handler( handler ),
+            m_seconds( 0 ),
+            m_deadline( 0 ),
+            m_armed( false ),
+            m_stopping( false ),
+            m_thread( *this )
+        {
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        ~Watchdog
+        ()
+        {
+            {
+                ScopedLock lock( m_mutex );
+                m_stopping = true;
+                m_changed.signal();
+            }
+            m_thread.join();
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        void arm
+        (
+            unsigned int seconds
+        )
+        {
+            ScopedLock lock( m_mutex );
+            m_seconds = seconds;
+            m_deadline = getCurrentMilliseconds() + seconds * 1000ULL;
+            m_armed = true;
+            m_changed.signal();
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        void disarm
+        ()
+        {
+            ScopedLock lock( m_mutex );
+            m_armed = false;
+            m_changed.signal();
+        }
+
+    private: // IRunnable
+
+        ///////////////////////////////////////////////////////////////////////
+        virtual void run
+        ()
+        {
+            for(;;)
+            {
+                unsigned int seconds = 0;
+                {
+                    ScopedLock lock( m_mutex );
+                    for(;;)
+                    {
+                        if( m_stopping )
+                            return;
+                        if( !m_armed )
+                        {
+                            m_changed.wait( m_mutex );
+                            continue;
+                        }
+                        unsigned long long now = getCurrentMilliseconds();
+                        if( now >= m_deadline )
+                            break;
+                        m_changed.waitFor( m_mutex, static_cast<unsigned int>( m_deadline - now ) );
+                    }
+                    m_armed = false;
+                    seconds = m_seconds;
+                }
+                m_handler.timedOut( seconds );
+            }
+        }
+
+    private:
+        ITimeoutHandler& m_handler;
+        unsigned int m_seconds;
+        unsigned long long m_deadline;
+        bool m_armed;
+        bool m_stopping;
+
+        Mutex m_mutex;
+        Condition m_changed;
+        Thread m_thread;
+    };
+
+} // end namespace Catch
+
+#endif // TWOBLUECUBES_CATCH_WATCHDOG_HPP_INCLUDED
@@ -11,6 +11,7 @@
 #ifndef TWOBLUECUBES_CATCH_XMLWRITER_HPP_INCLUDED
 #define TWOBLUECUBES_CATCH_XMLWRITER_HPP_INCLUDED
 
+#include <cstdio>
 #include <sstream>
 #include <string>
 #include <vector>
@@ -186,7 +187,7 @@ namespace Catch
             if( !name.empty() && !attribute.empty() )
             {
                 stream() << " " << name << "=\"";
-                writeEncodedText( attribute );
+                writeEncodedText( attribute, true );
                 stream() << "\"";
             }
             return *this;
@@ -289,36 +290,44 @@ namespace Catch
         }
         
         ///////////////////////////////////////////////////////////////////////
+        // Escapes the characters that would end or break the text (or, in an
+        // attribute, be normalised away by the parser). Control characters
+        // that XML 1.0 has no way of representing are written as \xNN
         void writeEncodedText
         (
-            const std::string& text
-        )
-        {
-            // !TBD finish this
-            if( !findReplaceableString( text, "<", "&lt;" ) &&
-               !findReplaceableString( text, "&", "&amp;" ) &&
-               !findReplaceableString( text, "\"", "&quote;" ) )
-            {
-                stream() << text;
-            }
-        }
-        
-        ///////////////////////////////////////////////////////////////////////
-        bool findReplaceableString
-        (
-            const std::string& text, 
-            const std::string& replaceWhat, 
-            const std::string& replaceWith
+            const std::string& text,
+            bool inAttribute = false
         )
         {
-            std::string::size_type pos = text.find_first_of( replaceWhat );
-            if( pos != std::string::npos )
+            for( std::size_t i = 0; i < text.size(); ++i )
             {
-                stream() << text.substr( 0, pos ) << replaceWith;
-                writeEncodedText( text.substr( pos+1 ) );
-                return true;
+                char c = text[i];
+                switch( c )
+                {
+                    case '<':   stream() << "&lt;";     break;
+                    case '&':   stream() << "&amp;";    break;
+                    case '"':   stream() << "&quot;";   break;
+                    case '\t':
+                    case '\n':
+                    case '\r':
+                        if( inAttribute )
+                            stream() << "&#x" << std::hex << static_cast<int>( c ) << std::dec << ";";
+                        else
+                            stream() << c;
+                        break;
+                    default:
+                        if( static_cast<unsigned char>( c ) < 0x20 )
+                        {
+                            char escaped[8];
+                            std::sprintf( escaped, "\\x%02x", static_cast<unsigned int>( c ) );
+                            stream() << escaped;
+                        }
+                        else
+                        {
+                            stream() << c;
+                        }
+                }
             }
-            return false;
         }
         
         bool m_tagIsOpen;